@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Everything that can be set from the command line
+struct Options
+{
+  int mazeWidth = 50; // Maze width in maze cells
+  int mazeHeight = 50; // Maze height in maze cells
+  int mazeCount = 1; // Number of mazes the headless mode generates
+  std::uint64_t seed = 0; // Seed of the first maze
+  std::string algorithm = "backtracker"; // One of maze::GeneratorNames()
+  std::string speed = "1"; // Label of the GUI's initial speed
+  std::filesystem::path outputDirectory = "."; // Where the headless mode writes its mazes
+  std::vector<int> benchmarkSizes; // Maze sizes the benchmarks use instead of their own
+  std::filesystem::path streamOutput = "-"; // Where the streaming mode writes its rows, - being stdout
+  int threadCount = 0; // Threads of the headless and tiled modes, 0 being one per hardware thread
+  int tileSize = 256; // Width and height of the tiles in the tiled mode
+  std::filesystem::path mappedFile; // File the mapped mode generates its maze in
+  std::string outputFormat = "text"; // Format of the headless and streaming modes' output, text, binary or png
+  int pathWidth = 3; // Path width in pixels of png images
+  int chunkSize = 64; // Width and height of the chunks of the infinite maze
+  std::filesystem::path readFile; // Binary maze file the read mode prints
+  int firstRow = 0; // First row the read mode prints
+  int endRow = -1; // Row after the last one the read mode prints, -1 being the end of the maze
+  std::string solver = "all"; // One of maze::SolverNames() or all of them
+  int fromX = 0; // Cell the solvers start at
+  int fromY = 0;
+  int toX = -1; // Cell the solvers look for, -1 being the last column or row
+  int toY = -1;
+};
+
+// Window-less entry points of the command line interface
+// They only use the maze library and never touch olc::PixelGameEngine
+
+// Runs one of the benchmarks and prints its results, returns 1 if there is no benchmark with that name
+//   grids: mazes of growing size on both grid types, time and memory per cell
+//   backtracker: cells per second of the backtracker's hot loop on a 10M cell maze
+//   chunked: eller and the backtracker on a chunked grid that releases finished pages, peak memory per cell against 0.375 of a flat grid
+//   layouts: the backtracker on the row-major and the Morton ordered grid at 8k and 32k squared cells, time and cache misses per cell
+//   fixed: 50x50 mazes with the size as a template argument against the runtime sized backtracker
+//   stackless: the backtracker on a CellGrid with a stack and with parent pointers, time and memory per cell
+//   algorithms: throughput and memory of every generation algorithm at 1k, 4k and 16k squared cells
+//   batch: mazes per second and latency of 10000 50x50 mazes on the batch farm with 1, 2, 4, ... threads
+//   tiled: throughput of the tiled generation on a 4k squared maze with 1, 2, 4, ... threads and the spread between the threads
+//   infinite: chunks of the infinite maze per second at random places and while panning a window-sized view, with the hits of the chunk cache
+//   solvers: every solver from one corner to the other of a 1k, 4k and 16k squared maze, cells per second and path length
+//   distances: build time and size of the distance index at 256, 1k and 4k squared cells, distances and paths per second between random cells
+//   field: the distance field from the top left cell of a 4k squared maze with 1, 2, 4, ... threads, throughput and how the cells were spread
+int RunBenchmark(const std::string& name, const Options& options);
+
+// Generates mazes on a work-stealing thread pool without a frame loop and writes each one to its own text, binary or png file
+// Maze number i is generated from seed + i, prints mazes per second and the latency percentiles of a single maze
+int RunHeadless(const Options& options);
+
+// Streams a single maze row by row with Eller's algorithm to streamOutput as text or png, memory only grows with the width
+// A height of 0 keeps going until the output can not be written anymore, which only works for text
+int RunStream(const Options& options);
+
+// Generates a single maze directly in a memory mapped file, which can be larger than the physical memory
+// Eller finishes the maze from top to bottom, with it the finished rows are written back and dropped from memory as it goes
+// Eller is the default here, the other algorithms keep state for every cell on the heap and are refused from 2^32 cells on
+// The file can be opened again with --read, which maps it instead of loading it
+int RunMapped(const Options& options);
+
+// Prints the rows from firstRow to endRow of a binary maze file or a file of the mapped mode as text, only those rows are read from the file
+int RunRead(const Options& options);
+
+// Finds a path from the cell at fromX and fromY to the one at toX and toY with one or all of the solvers
+// The maze is read from readFile if there is one and generated otherwise, prints the time, the cells per second and the path length of every solver
+int RunSolve(const Options& options);
+
+// Measures dead ends, junctions, corridor lengths, diameter and straightness of the maze and prints them
+// The maze is read from readFile if there is one and generated otherwise, the diameter is found on threadCount threads
+int RunAnalyze(const Options& options);
+
+// Generates a single maze on many threads, one tile at a time, and writes it to maze_tiled.txt in outputDirectory
+// Prints how many tiles and cells every thread generated and how fast
+int RunTiled(const Options& options);
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "maze/Direction.h"
+#include "maze/PackedGrid.h"
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace maze
+{
+  // Structural measures of a maze, for grading mazes against each other
+  // A corridor is a run of cells with exactly two passages between two cells that have any other number of them
+  struct MazeAnalysis
+  {
+    std::int64_t cells = 0;
+    std::int64_t passages = 0;
+    std::int64_t deadEnds = 0; // Cells with a single passage
+    std::int64_t corridorCells = 0; // Cells with two passages
+    std::int64_t straightCells = 0; // Corridor cells whose two passages lie opposite of each other
+    std::int64_t threeWayJunctions = 0; // Cells with three passages
+    std::int64_t fourWayJunctions = 0; // Cells with four passages
+    std::vector<std::int64_t> corridorLengths; // Number of corridors by their length, the steps from one end to the other
+    std::int64_t diameter = 0; // Steps between the two cells furthest apart
+    Point diameterStart = {0, 0};
+    Point diameterEnd = {0, 0};
+    double straightness = 0.0; // Share of corridor cells that go straight on
+    double riverFactor = 0.0; // Mean length of the corridors that end in a dead end, mazes that flow long ways before they branch score high
+    double seconds = 0.0; // Time the analysis took
+  };
+
+  // Measures the maze in time linear in its cells
+  // Passages are counted 64 cells at a time from the passage bits with popcounts, the corridors are followed once from their ends,
+  // the diameter is the furthest distance from the cell that is furthest from the top left cell (two distance fields on threadCount threads)
+  // The diameter is exact for a perfect maze and a lower bound for a maze with loops, runs of corridor cells that form a ring without any ends are not counted as corridors
+  // threadCount 0 uses one thread per hardware thread
+  MazeAnalysis AnalyzeMaze(const PackedGrid& grid, int threadCount = 0);
+
+  // Writes the analysis as lines of text, the corridor lengths grouped into ranges that double in size
+  void WriteAnalysis(const MazeAnalysis& analysis, std::ostream& output);
+}
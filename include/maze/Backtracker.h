@@ -0,0 +1,74 @@
+#pragma once
+
+#include "maze/CellGrid.h"
+#include "maze/ChunkedGrid.h"
+#include "maze/Generator.h"
+#include "maze/MortonGrid.h"
+#include "maze/NeighbourMask.h"
+#include "maze/PackedGrid.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace maze
+{
+  // Recursive backtracker: walks into a random unvisited neighbour and backtracks once it is stuck
+  // The path back to the start is a contiguous stack of 32 bit cell indices, so the indices of the grid have to fit into 32 bits
+  // On a CellGrid it can also run without a stack: every cell already points to its parent, which is exactly where backtracking leads
+  // Grid is CellGrid, PackedGrid, MortonGrid or ChunkedGrid, all of them are instantiated in Backtracker.cpp
+  template<typename Grid>
+  class Backtracker final : public Generator<Grid>
+  {
+  public:
+    // A stackless backtracker follows the parent pointers of the grid and needs no memory besides it, which only a CellGrid has
+    // Throws std::invalid_argument if the grid's indices do not fit into 32 bits and a stack is used, or if it has no parent pointers and none is used
+    explicit Backtracker(Grid& grid, bool isStackless = false);
+
+    // Starts the maze in the top leftmost cell
+    void Reset(std::uint64_t seed) override { Reset(seed, Point{0, 0}); }
+
+    // Clears the grid and puts the starting cell of a new maze onto the stack
+    void Reset(std::uint64_t seed, Point start);
+
+    // Advances the maze by one cell (either visiting a new cell or backtracking by one)
+    bool Step() override;
+
+    void Run() override;
+
+    bool IsDone() const override { return visitedCellsCounter >= grid.CellCount(); }
+
+    // The cell on the top of the stack
+    bool HasCurrentCell() const override { return isStackless or not path.empty(); }
+    Point CurrentCell() const override { return current; }
+
+    // Only the part of the stack that has actually been written to, the rest of the reservation is never touched
+    std::size_t MemoryUsage() const override { return peakStackSize * sizeof(std::uint32_t); }
+
+    bool IsStackless() const { return isStackless; }
+
+    std::int64_t VisitedCells() const { return visitedCellsCounter; }
+    std::size_t PeakStackSize() const { return peakStackSize; }
+
+  private:
+    using Generator<Grid>::grid;
+    using Generator<Grid>::random;
+
+    bool isStackless; // Backtracks along the parent pointers of the grid instead of popping a stack
+    std::int64_t visitedCellsCounter; // Number of cells that have been visited
+    std::vector<std::uint32_t> path; // Indices of the cells from the starting cell to the current cell, reserved for the whole maze
+    std::int64_t currentIndex = 0; // Index of the cell on the top of the stack
+    Point current = {0, 0}; // Coordinates of the cell on the top of the stack, kept up to date so that the bounds checks need no division
+    std::size_t peakStackSize = 0; // Deepest the stack got while generating the current maze, stays 0 without a stack
+
+    // Returns every direction whose neighbour lies inside the maze and has not been visited yet
+    NeighbourMask validNeighbours() const;
+
+    // Moves the current cell to its neighbour
+    void moveCurrent(Direction direction);
+  };
+
+  extern template class Backtracker<CellGrid>;
+  extern template class Backtracker<PackedGrid>;
+  extern template class Backtracker<MortonGrid>;
+  extern template class Backtracker<ChunkedGrid>;
+}
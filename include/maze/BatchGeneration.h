@@ -0,0 +1,29 @@
+#pragma once
+
+#include "maze/PackedGrid.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace maze
+{
+  // Called for every finished maze of a batch, from the thread that generated it
+  // job is the number of the maze within the batch, the grid is only valid until the call returns
+  using BatchSink = std::function<void(std::int64_t job, const PackedGrid& grid)>;
+
+  struct BatchStatistics
+  {
+    double seconds = 0.0; // Wall clock time of the whole batch
+    std::vector<double> jobSeconds; // Time from starting a job until its sink returned, by job number
+    std::vector<std::int64_t> jobsPerWorker; // Number of jobs every thread finished
+    std::vector<std::int64_t> stealsPerWorker; // Number of times a thread took work from another one
+  };
+
+  // Generates count independent mazes of the same size on a work-stealing thread pool, maze number i from seed + i
+  // Every thread starts with an equal share of the jobs and takes the back half of another thread's share once it runs out
+  // The grid and generator of a thread are reused from one job to the next, so a job does not allocate
+  // threadCount 0 uses one thread per hardware thread, algorithm is one of GeneratorNames()
+  BatchStatistics GenerateBatch(int width, int height, const std::string& algorithm, std::uint64_t seed, std::int64_t count, int threadCount, const BatchSink& sink);
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "maze/Direction.h"
+#include "maze/MappedFile.h"
+#include "maze/PackedGrid.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string>
+
+namespace maze
+{
+  // Layout of a binary maze file, all numbers are little endian
+  //   header: MazeFileHeader, 64 bytes
+  //   rows: every row takes the same number of bytes, first its "open to the right" bits, then its "open downwards" bits,
+  //         one bit per cell, filled up to whole 64 bit words
+  //   index (optional): a MazeFileBlock for every rowsPerBlock rows, starting at indexOffset
+  // Finished mazes have every cell visited, so unlike PackedGrid the file has no visited bits
+  struct MazeFileHeader
+  {
+    char magic[8]; // "MAZEFILE"
+    std::uint32_t version;
+    std::uint32_t rowsPerBlock; // Rows covered by an entry of the index, 0 if there is no index
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint64_t seed;
+    char algorithm[16]; // Name of the algorithm, filled up with 0
+    std::uint64_t indexOffset; // Where the index starts in the file, 0 if there is no index
+    std::uint8_t reserved[8];
+  };
+
+  static_assert(sizeof(MazeFileHeader) == 64);
+
+  // An entry of the index, lets a reader check a range of rows without reading the rest of the file
+  struct MazeFileBlock
+  {
+    std::uint64_t offset; // Where the first row of the block starts in the file
+    std::uint64_t checksum; // Of the words of all rows in the block
+  };
+
+  // Writes the finished maze in the binary format, with an index entry every rowsPerBlock rows or without an index if rowsPerBlock is 0
+  // Throws std::invalid_argument if the algorithm's name does not fit into the header or rowsPerBlock is negative
+  void WriteBinary(const PackedGrid& grid, std::uint64_t seed, const std::string& algorithm, std::ostream& output, int rowsPerBlock = 64);
+
+  // A range of rows of a maze file, read straight from the mapping
+  // The rows act as a maze of their own, the first row has no passages upwards and the last one none downwards
+  class MazeFileRows
+  {
+  public:
+    MazeFileRows(const std::uint8_t* rows, int width, int height, std::size_t rowBytes) :
+      rows(rows),
+      width(width),
+      height(height),
+      rowBytes(rowBytes)
+    {}
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+
+    bool IsOpenRight(int x, int y) const { return Bit(x, y, 0); }
+    bool IsOpenDown(int x, int y) const { return y < height - 1 and Bit(x, y, rowBytes / 2); }
+
+    // Returns true if there is a passage between the cell at x and y and its neighbour
+    bool IsPassage(int x, int y, Direction direction) const;
+
+  private:
+    const std::uint8_t* rows;
+    int width;
+    int height;
+    std::size_t rowBytes;
+
+    // Bits are stored little endian, so byte x / 8 of a plane holds bit x % 8 no matter how words are ordered in memory
+    bool Bit(int x, int y, std::size_t plane) const
+    {
+      return (rows[y * rowBytes + plane + (x >> 3)] >> (x & 7)) & 1;
+    }
+  };
+
+  // A binary maze file mapped into memory read only
+  // Nothing is decoded up front, rows are paged in by the operating system once they are read
+  class MazeFile
+  {
+  public:
+    // Throws std::runtime_error if the file can not be mapped, is no maze file or is cut off
+    explicit MazeFile(const std::filesystem::path& path);
+
+    int Width() const { return int(header.width); }
+    int Height() const { return int(header.height); }
+    std::uint64_t Seed() const { return header.seed; }
+    std::string Algorithm() const;
+
+    bool HasIndex() const { return header.indexOffset != 0; }
+    int RowsPerBlock() const { return int(header.rowsPerBlock); }
+
+    // The rows from first to before end, without copying them
+    // If the file has an index, the blocks the rows lie in are checked first and std::runtime_error is thrown if one does not match
+    // Throws std::invalid_argument if the range does not lie inside the maze
+    MazeFileRows Rows(int first, int end) const;
+
+    // Checks every block of the index, returns false if one does not match and true if there is no index
+    bool Verify() const;
+
+    // Decodes the whole maze into a grid, every cell of it is visited
+    PackedGrid Load() const;
+
+  private:
+    MappedFile file;
+    MazeFileHeader header;
+    std::size_t rowBytes;
+
+    // Entry of the index in the byte order of this machine
+    MazeFileBlock Block(int block) const;
+
+    // Returns true if the checksum of the rows in the block matches the index
+    bool IsBlockIntact(int block) const;
+  };
+}
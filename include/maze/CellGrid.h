@@ -0,0 +1,70 @@
+#pragma once
+
+#include "maze/Direction.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace maze
+{
+  struct cell
+  {
+    bool visited = false;
+    // Points towards the cell this cell has been reached from, the starting cell stays NOT_SET
+    Direction direction = NOT_SET;
+  };
+
+  // A row-major, heap allocated grid of cells
+  // Every visited cell except the starting one points to its parent, which makes the maze a tree
+  class CellGrid
+  {
+  public:
+    CellGrid(int width, int height);
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+    std::int64_t CellCount() const { return std::int64_t(width) * height; }
+
+    std::int64_t Index(int x, int y) const { return std::int64_t(y) * width + x; }
+    Point Coordinates(std::int64_t index) const { return Point{int(index % width), int(index / width)}; }
+
+    cell& operator[](std::int64_t index) { return cells[index]; }
+    const cell& operator[](std::int64_t index) const { return cells[index]; }
+
+    bool IsVisited(std::int64_t index) const { return cells[index].visited; }
+    void MarkVisited(std::int64_t index) { cells[index].visited = true; }
+
+    // Marks the neighbour of the cell as visited and makes it point back to the cell
+    void Carve(std::int64_t index, Direction direction);
+
+    // Returns the index of the neighbour towards direction, which has to lie inside the maze
+    std::int64_t Neighbour(std::int64_t index, Direction direction) const
+    {
+      switch (direction)
+      {
+        case UP: return index - width;
+        case LEFT: return index - 1;
+        case DOWN: return index + width;
+        case RIGHT: return index + 1;
+        default: return index;
+      }
+    }
+
+    // Returns true if the neighbour of the cell at x and y lies inside the maze
+    bool HasNeighbour(int x, int y, Direction direction) const;
+
+    // Returns true if there is a passage between the cell at x and y and its neighbour
+    bool IsPassage(int x, int y, Direction direction) const;
+
+    // Marks every cell as unvisited and without a direction
+    void Clear();
+
+    // Heap memory used by the cells in bytes
+    std::size_t MemoryUsage() const { return cells.capacity() * sizeof(cell); }
+
+  private:
+    int width;
+    int height;
+    std::vector<cell> cells;
+  };
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "maze/Direction.h"
+#include "maze/NeighbourMask.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace maze
+{
+  // The same three bits per cell as PackedGrid, split into pages of 64x64 cells that are only allocated once a bit in them is set
+  // Untouched parts of the maze cost nothing besides one pointer per page
+  // With a page sink, a page is handed to the sink and freed as soon as it can not change anymore, so memory follows the part of the maze that is still being worked on
+  // Indices are y * stride + x with the stride being the width rounded up to a power of two, the padding is never allocated
+  class ChunkedGrid
+  {
+  public:
+    static const int PageSize = 64; // Width and height of a page in cells
+
+    // Called with the position of a finished page (in pages) before it is freed
+    // The sink may read the page's own cells with IsOpenRight() and IsOpenDown(), pages that have been released before read as closed
+    using PageSink = std::function<void(const ChunkedGrid& grid, int pageX, int pageY)>;
+
+    // Throws std::invalid_argument if a side is smaller than 1
+    ChunkedGrid(int width, int height);
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+    std::int64_t CellCount() const { return std::int64_t(width) * height; }
+
+    std::int64_t Index(int x, int y) const { return (std::int64_t(y) << strideBits) | x; }
+    Point Coordinates(std::int64_t index) const { return Point{int(index & strideMask), int(index >> strideBits)}; }
+
+    // Cells of released pages count as visited, so generators never walk back into them
+    bool IsVisited(std::int64_t index) const { return Bit(index, VISITED); }
+    void MarkVisited(std::int64_t index) { SetBit(index, VISITED); }
+
+    // Opens the wall between the cell and its neighbour and marks the neighbour as visited
+    void Carve(std::int64_t index, Direction direction);
+
+    bool IsOpenRight(std::int64_t index) const { return Bit(index, OPEN_RIGHT); }
+    bool IsOpenDown(std::int64_t index) const { return Bit(index, OPEN_DOWN); }
+
+    // Returns the index of the neighbour towards direction, which has to lie inside the maze
+    std::int64_t Neighbour(std::int64_t index, Direction direction) const
+    {
+      switch (direction)
+      {
+        case UP: return index - (std::int64_t(1) << strideBits);
+        case LEFT: return index - 1;
+        case DOWN: return index + (std::int64_t(1) << strideBits);
+        case RIGHT: return index + 1;
+        default: return index;
+      }
+    }
+
+    // Returns true if the neighbour of the cell at x and y lies inside the maze
+    bool HasNeighbour(int x, int y, Direction direction) const;
+
+    // Returns every direction whose neighbour lies inside the maze
+    NeighbourMask Neighbours(int x, int y) const
+    {
+      return NeighbourMask((y > 0) * MaskOf(UP) | (x > 0) * MaskOf(LEFT) | (y < height - 1) * MaskOf(DOWN) | (x < width - 1) * MaskOf(RIGHT));
+    }
+
+    // Returns true if there is a passage between the cell at x and y and its neighbour
+    bool IsPassage(int x, int y, Direction direction) const;
+
+    // Returns true if the cell at x and y is closed off towards direction, the border counts as a wall
+    bool HasWall(int x, int y, Direction direction) const { return not IsPassage(x, y, direction); }
+
+    // Frees every page, which closes every wall and marks every cell as unvisited
+    void Clear();
+
+    // Hands finished pages to sink and frees them, without a sink (the default) pages are kept until Clear()
+    // A page is finished once it and its right and lower neighbours are fully visited, which even a row by row generator like Eller has left behind by then
+    // The lowest row of pages has no lower neighbours to wait for, it is handed over by Flush()
+    void SetPageSink(PageSink sink) { pageSink = std::move(sink); }
+
+    // Hands every page that is still allocated to the sink and frees it, to be called once the maze is finished
+    void Flush();
+
+    int PagesX() const { return pagesX; }
+    int PagesY() const { return pagesY; }
+
+    // Number of pages that are allocated right now and the most there have been since the last Clear()
+    std::int64_t AllocatedPages() const { return allocatedPages; }
+    std::int64_t PeakAllocatedPages() const { return peakAllocatedPages; }
+
+    // Heap memory in bytes, the pages that are allocated right now plus the page table
+    std::size_t MemoryUsage() const { return allocatedPages * sizeof(Page) + PageTableMemoryUsage(); }
+
+    // Heap memory in bytes at the peak since the last Clear()
+    std::size_t PeakMemoryUsage() const { return peakAllocatedPages * sizeof(Page) + PageTableMemoryUsage(); }
+
+  private:
+    // Offsets of the three words of a row of a page
+    enum Plane
+    {
+      OPEN_RIGHT,
+      OPEN_DOWN,
+      VISITED,
+      PLANE_COUNT
+    };
+
+    enum PageState : std::uint8_t
+    {
+      UNTOUCHED, // Not allocated, every bit reads as 0
+      ALLOCATED,
+      RELEASED // Handed to the sink and freed, reads as visited without passages
+    };
+
+    // Every row of 64 cells is one word per plane
+    struct Page
+    {
+      std::uint64_t words[PageSize * PLANE_COUNT] = {};
+    };
+
+    int width;
+    int height;
+    int strideBits; // Indices advance by 2^strideBits per row
+    std::int64_t strideMask;
+    int pagesX;
+    int pagesY;
+    std::vector<std::unique_ptr<Page>> pages;
+    std::vector<PageState> pageStates;
+    std::vector<std::uint16_t> visitedCells; // Visited cells per page
+    std::int64_t allocatedPages = 0;
+    std::int64_t peakAllocatedPages = 0;
+    PageSink pageSink;
+
+    std::size_t PageTableMemoryUsage() const
+    {
+      return pages.capacity() * sizeof(std::unique_ptr<Page>) + pageStates.capacity() * sizeof(PageState) + visitedCells.capacity() * sizeof(std::uint16_t);
+    }
+
+    std::int64_t PageOf(std::int64_t index) const
+    {
+      return ((index >> strideBits) / PageSize) * pagesX + (index & strideMask) / PageSize;
+    }
+
+    // Position of the word of the cell inside its page
+    int WordOf(std::int64_t index, Plane plane) const { return int((index >> strideBits) % PageSize) * PLANE_COUNT + plane; }
+
+    bool Bit(std::int64_t index, Plane plane) const
+    {
+      const Page* page = pages[PageOf(index)].get();
+
+      if (page == nullptr)
+      {
+        return plane == VISITED and pageStates[PageOf(index)] == RELEASED;
+      }
+
+      return (page->words[WordOf(index, plane)] >> (index & 63)) & 1;
+    }
+
+    void SetBit(std::int64_t index, Plane plane);
+
+    // Number of cells of a page that lie inside the maze, the pages at the right and lower border can be cut off
+    int CellsOfPage(std::int64_t page) const;
+
+    bool IsPageFull(std::int64_t page) const;
+
+    // Hands the page to the sink and frees it if it is finished
+    void TryReleasePage(int pageX, int pageY);
+  };
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace maze
+{
+  // Receives compressed bytes, the pointer is only valid until the call returns
+  using DeflateSink = std::function<void(const std::uint8_t* data, std::size_t length)>;
+
+  // A zlib stream (RFC 1950 and 1951) of data made of lines that all have the same length, such as the pixel rows of an image
+  // A line that repeats the one before it becomes a few back-references instead of being searched for matches,
+  // every other line is Huffman coded byte by byte with a code built for each block of lines
+  // Drawn mazes use only a handful of different bytes, so this compresses them about as well as zlib's fastest level at many times its speed
+  class LineDeflater
+  {
+  public:
+    // Hands the compressed bytes to sink in pieces of about blockSize bytes
+    LineDeflater(std::size_t lineLength, DeflateSink sink, std::size_t blockSize = 1 << 18);
+
+    // Adds the next line, lineLength bytes
+    void AddLine(const std::uint8_t* line);
+
+    // Adds the previous line once more
+    void RepeatLine();
+
+    // Ends the stream, nothing can be added afterwards
+    void Finish();
+
+  private:
+    std::size_t lineLength;
+    DeflateSink sink;
+    std::size_t blockSize;
+
+    std::vector<std::uint8_t> literals; // The lines of the current block that are not repeats
+    std::vector<std::uint8_t> isRepeat; // Whether a line of the current block is a repeat
+    std::vector<std::uint8_t> previousLine; // For repeating a line when it can not be a back-reference
+    std::vector<std::uint16_t> repeatLengths; // A repeated line split into back-references of at most 258 bytes
+    bool canReference; // Whether a whole line fits into the 32k window of back-references
+
+    std::uint32_t adler = 1; // Checksum of the uncompressed data
+    std::vector<std::uint8_t> output; // Compressed bytes that have not been handed to the sink
+    std::uint64_t bitBuffer = 0;
+    int bitCount = 0;
+
+    // Appends the lowest count bits of bits to the output, the first bit going into the lowest free bit of the current byte
+    void PutBits(std::uint32_t bits, int count)
+    {
+      bitBuffer |= std::uint64_t(bits) << bitCount;
+      bitCount += count;
+
+      if (bitCount >= 32)
+      {
+        std::uint8_t bytes[4] = {std::uint8_t(bitBuffer), std::uint8_t(bitBuffer >> 8), std::uint8_t(bitBuffer >> 16), std::uint8_t(bitBuffer >> 24)};
+        output.insert(output.end(), bytes, bytes + 4);
+
+        bitBuffer >>= 32;
+        bitCount -= 32;
+      }
+    }
+
+    // Writes the current block with a Huffman code of its own
+    void WriteBlock(bool isLast);
+  };
+}
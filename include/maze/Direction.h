@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+namespace maze
+{
+  enum Direction : std::uint8_t
+  {
+    NOT_SET,
+    UP,
+    LEFT,
+    DOWN,
+    RIGHT
+  };
+
+  // Returns the direction pointing the other way (NOT_SET stays NOT_SET)
+  constexpr Direction Reverse(Direction direction)
+  {
+    switch (direction)
+    {
+      case UP: return DOWN;
+      case LEFT: return RIGHT;
+      case DOWN: return UP;
+      case RIGHT: return LEFT;
+      default: return NOT_SET;
+    }
+  }
+
+  // Coordinates of a cell, measured in maze cells
+  struct Point
+  {
+    int x;
+    int y;
+  };
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "maze/Direction.h"
+#include "maze/PackedGrid.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace maze
+{
+  // Distance of a cell that can not be reached from the start
+  constexpr std::uint32_t unreachedDistance = 0xffffffff;
+
+  struct DistanceFieldStatistics
+  {
+    double seconds = 0.0; // Wall clock time of the whole field
+    std::vector<std::int64_t> cellsPerWorker; // Number of cells every thread expanded
+    std::vector<std::int64_t> stealsPerWorker; // Number of times a thread took cells from another one
+    std::uint32_t maximumDistance = 0; // Distance of the cell furthest from the start
+  };
+
+  // Fills distances with the number of steps from the start to every cell, indexed like the grid, on threadCount threads
+  // A maze's frontier stays at a few dozen cells over millions of levels, so instead of going level by level every thread walks depth first from cells of its own
+  // A cell is handed on whenever its distance gets lower, which in a perfect maze happens exactly once per cell, no matter in which order the cells come
+  // In a maze with loops a cell can be lowered more than once before it settles on its shortest distance
+  // Each thread keeps a private stack and puts its oldest cells up for others to take, idle threads take half of another thread's shared cells
+  // threadCount 0 uses one thread per hardware thread
+  // Throws std::invalid_argument if the start does not lie inside the maze
+  DistanceFieldStatistics ComputeDistanceField(const PackedGrid& grid, Point start, std::vector<std::uint32_t>& distances, int threadCount = 0);
+}
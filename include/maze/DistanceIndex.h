@@ -0,0 +1,61 @@
+#pragma once
+
+#include "maze/Direction.h"
+#include "maze/PackedGrid.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace maze
+{
+  // Answers how far apart two cells of a perfect maze are in constant time
+  // A perfect maze is a tree, the distance of two cells is their depths below a root minus twice the depth of their lowest common ancestor
+  // The ancestor is found with a range minimum query over the depths in depth first order, for u before v it is the parent of the shallowest cell after u up to v
+  // The range minimum uses a sparse table over blocks of 64 cells and, inside a block, a bitmask per cell of the cells before it that are smaller than everything up to it
+  // Takes about 21 bytes per cell, 20 for the positions, cells, depths and masks and about one for the sparse table
+  // Built once in linear time with a stack of up to 8 bytes per cell, the grid has to outlive the index and may not change anymore
+  class DistanceIndex
+  {
+  public:
+    // Walks the maze from the root
+    // Throws std::invalid_argument if the maze has 2^32 cells or more or the root does not lie inside it
+    explicit DistanceIndex(const PackedGrid& grid, Point root = {0, 0});
+
+    // Steps from the root to the cell, -1 if the cell can not be reached from it (only in unfinished mazes)
+    std::int64_t Depth(std::int64_t index) const;
+
+    // The cell where the paths from the root to both cells part, -1 if one of them can not be reached
+    std::int64_t CommonAncestor(std::int64_t a, std::int64_t b) const;
+
+    // Steps between two cells, -1 if one of them can not be reached
+    std::int64_t Distance(std::int64_t a, std::int64_t b) const;
+    std::int64_t Distance(Point a, Point b) const { return Distance(grid.Index(a.x, a.y), grid.Index(b.x, b.y)); }
+
+    // Indices of the cells from a to b, both included, empty if one of them can not be reached
+    // Takes time in the length of the path
+    std::vector<std::int64_t> Path(std::int64_t a, std::int64_t b) const;
+
+    // Memory used by the index in bytes
+    std::size_t MemoryUsage() const;
+
+  private:
+    static constexpr std::uint32_t unreached = 0xffffffff;
+
+    const PackedGrid& grid;
+
+    std::vector<std::uint32_t> positions; // Where a cell comes in depth first order, unreached if it does not
+    std::vector<std::uint32_t> cells; // The cell at each position
+    std::vector<std::uint32_t> depths; // The depth of the cell at each position
+    std::vector<std::uint64_t> minimumMasks; // For each position, the positions of its block up to it whose depth is smaller than every later one up to it
+    std::vector<std::uint32_t> blockMinimums; // Row k holds the position of the smallest depth in 2^k blocks starting at each block
+    std::size_t blockCount = 0;
+
+    // The neighbour one step closer to the root
+    std::int64_t Parent(std::int64_t index) const;
+
+    // Position of the smallest depth from first to last, both included
+    std::uint32_t Minimum(std::uint32_t first, std::uint32_t last) const;
+
+    std::uint32_t Shallower(std::uint32_t a, std::uint32_t b) const { return depths[b] < depths[a] ? b : a; }
+  };
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "maze/ChunkedGrid.h"
+#include "maze/EllerStream.h"
+#include "maze/Generator.h"
+#include "maze/PackedGrid.h"
+
+#include <cstdint>
+
+namespace maze
+{
+  // Eller: builds the maze row by row, only remembering which cells of the current row are connected
+  // Randomly joins neighbouring sets within a row, then opens at least one passage downwards per set
+  // The last row joins all remaining sets
+  // The rows come from an EllerStream, so they are the same as the streamed ones for the same seed, Step() carves them one wall at a time
+  // Grid is either PackedGrid or ChunkedGrid, both are instantiated in Eller.cpp
+  template<typename Grid>
+  class Eller final : public Generator<Grid>
+  {
+  public:
+    explicit Eller(Grid& grid);
+
+    void Reset(std::uint64_t seed) override;
+
+    // Decides about one wall of the current row
+    bool Step() override;
+
+    void Run() override;
+
+    bool IsDone() const override { return row >= grid.Height(); }
+
+    // The cell whose wall is decided next
+    bool HasCurrentCell() const override { return not IsDone(); }
+    Point CurrentCell() const override { return Point{column, row}; }
+
+    std::size_t MemoryUsage() const override { return stream.MemoryUsage(); }
+
+  private:
+    using Generator<Grid>::grid;
+    using Generator<Grid>::lastCarving;
+
+    // What the current row is busy with
+    enum Phase
+    {
+      JOINING_RIGHT, // Opening the walls between neighbouring sets
+      OPENING_DOWN, // Opening the walls downwards
+    };
+
+    int row = 0;
+    int column = 0;
+    Phase phase = JOINING_RIGHT;
+
+    EllerStream stream; // Decides the walls of every row
+    const MazeRow* currentRow = nullptr; // Walls of the row being carved, owned by stream
+
+    // Has the stream decide the walls of the next row and moves on to it
+    void StartNextRow();
+  };
+
+  extern template class Eller<PackedGrid>;
+  extern template class Eller<ChunkedGrid>;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "maze/Random.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace maze
+{
+  // One finished row of a streamed maze, the walls of a row never change once it has been handed out
+  class MazeRow
+  {
+  public:
+    MazeRow() = default;
+
+    explicit MazeRow(int width) :
+      width(width),
+      openRight((width + 63) / 64, 0),
+      openDown((width + 63) / 64, 0)
+    {}
+
+    int Width() const { return width; }
+
+    // Row number, counted from the top of the maze
+    std::int64_t Y() const { return y; }
+
+    // Whether there is a passage between cell x and cell x + 1 of this row
+    bool IsOpenRight(int x) const { return (openRight[x >> 6] >> (x & 63)) & 1; }
+
+    // Whether there is a passage between cell x of this row and cell x of the next one
+    bool IsOpenDown(int x) const { return (openDown[x >> 6] >> (x & 63)) & 1; }
+
+    // The same bits as words of 64 cells, the layout PackedGrid::ReadRow() uses
+    const std::uint64_t* OpenRightBits() const { return openRight.data(); }
+    const std::uint64_t* OpenDownBits() const { return openDown.data(); }
+
+  private:
+    friend class EllerStream;
+
+    int width = 0;
+    std::int64_t y = -1;
+    std::vector<std::uint64_t> openRight; // One bit per cell
+    std::vector<std::uint64_t> openDown; // One bit per cell
+  };
+
+  // Eller's algorithm without a grid: produces a maze one finished row at a time
+  // It only remembers which cells of the current row are connected, so memory stays proportional to the width no matter how many rows are generated
+  // The step-wise Eller generator carves the rows of a stream, so both give the same rows for the same seed as long as the maze is not cut off
+  class EllerStream
+  {
+  public:
+    // Throws std::invalid_argument if width is smaller than 1
+    EllerStream(int width, std::uint64_t seed);
+
+    // Generates the next row
+    // The last row joins all sets that are still apart and opens no passage downwards, without it the maze is perfect down to the last row handed out but its bottom row still has openings downwards
+    const MazeRow& NextRow(bool isLastRow = false);
+
+    // Number of rows generated so far
+    std::int64_t RowCount() const { return row.y + 1; }
+
+    int Width() const { return width; }
+
+    // Heap memory in bytes
+    std::size_t MemoryUsage() const;
+
+  private:
+    int width;
+    Random random;
+    MazeRow row;
+
+    // Sets are numbered per row, at most 2 * width of them exist while a row is being worked on
+    std::vector<std::uint32_t> sets; // Set of every cell of the current row
+    std::vector<std::uint32_t> parents; // Union-find forest over the set numbers
+    std::vector<std::uint32_t> remainingCells; // Cells of a set in the current row that have not been looked at yet
+    std::vector<std::uint32_t> nextSets; // Sets of the next row
+    std::vector<bool> hasPassageDown; // Whether a set has already opened a passage downwards
+
+    std::uint32_t Find(std::uint32_t set);
+
+    // Renumbers the sets of the next row to 0 .. width - 1
+    void StartNextRow();
+  };
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "maze/Direction.h"
+#include "maze/NeighbourMask.h"
+#include "maze/Random.h"
+
+#include <array>
+#include <cstdint>
+
+namespace maze
+{
+  // A grid whose size is part of its type, so bounds checks and index math fold into constants
+  // Every cell is one byte of flags: "open to the right", "open downwards" and "visited"
+  // Everything is constexpr, a maze can be generated while compiling and stored in the binary as a constant
+  template<int W, int H>
+  class FixedGrid
+  {
+    static_assert(W > 0 and H > 0, "The maze needs to be at least 1x1 cells big");
+
+  public:
+    static constexpr int Width() { return W; }
+    static constexpr int Height() { return H; }
+    static constexpr std::int64_t CellCount() { return std::int64_t(W) * H; }
+
+    static constexpr std::int64_t Index(int x, int y) { return std::int64_t(y) * W + x; }
+    static constexpr Point Coordinates(std::int64_t index) { return Point{int(index % W), int(index / W)}; }
+
+    constexpr bool IsVisited(std::int64_t index) const { return cells[index] & VISITED; }
+    constexpr void MarkVisited(std::int64_t index) { cells[index] |= VISITED; }
+
+    constexpr bool IsOpenRight(std::int64_t index) const { return cells[index] & OPEN_RIGHT; }
+    constexpr bool IsOpenDown(std::int64_t index) const { return cells[index] & OPEN_DOWN; }
+
+    // Opens the wall between the cell and its neighbour and marks the neighbour as visited
+    constexpr void Carve(std::int64_t index, Direction direction)
+    {
+      // Walls to the left and above are stored in the neighbour
+      switch (direction)
+      {
+        case UP: cells[index - W] |= OPEN_DOWN | VISITED; break;
+        case LEFT: cells[index - 1] |= OPEN_RIGHT | VISITED; break;
+        case DOWN: cells[index] |= OPEN_DOWN; cells[index + W] |= VISITED; break;
+        case RIGHT: cells[index] |= OPEN_RIGHT; cells[index + 1] |= VISITED; break;
+        default: break;
+      }
+    }
+
+    // Returns true if the neighbour of the cell at x and y lies inside the maze
+    static constexpr bool HasNeighbour(int x, int y, Direction direction)
+    {
+      switch (direction)
+      {
+        case UP: return y > 0;
+        case LEFT: return x > 0;
+        case DOWN: return y < H - 1;
+        case RIGHT: return x < W - 1;
+        default: return false;
+      }
+    }
+
+    // Returns true if there is a passage between the cell at x and y and its neighbour
+    constexpr bool IsPassage(int x, int y, Direction direction) const
+    {
+      if (not HasNeighbour(x, y, direction))
+      {
+        return false;
+      }
+
+      switch (direction)
+      {
+        case UP: return IsOpenDown(Index(x, y - 1));
+        case LEFT: return IsOpenRight(Index(x - 1, y));
+        case DOWN: return IsOpenDown(Index(x, y));
+        case RIGHT: return IsOpenRight(Index(x, y));
+        default: return false;
+      }
+    }
+
+    constexpr bool HasWall(int x, int y, Direction direction) const { return not IsPassage(x, y, direction); }
+
+    // Closes every wall and marks every cell as unvisited
+    constexpr void Clear() { cells.fill(0); }
+
+  private:
+    enum Flag : std::uint8_t
+    {
+      OPEN_RIGHT = 1,
+      OPEN_DOWN = 2,
+      VISITED = 4
+    };
+
+    std::array<std::uint8_t, std::size_t(W) * H> cells{};
+  };
+
+  // Generates a maze with the recursive backtracker, starting in the top leftmost cell
+  // It makes the same choices as Backtracker, so a seed gives the same maze as Backtracker<PackedGrid> on a grid of the same size
+  // Usable in constant expressions, e.g. constexpr auto level = GenerateFixed<16, 16>(42); costs nothing at runtime
+  // The stack lives inside the function, large sizes may need a higher -fconstexpr-ops-limit when evaluated while compiling
+  // Called at runtime, that stack takes 4 bytes per cell and the grid another byte per cell of the thread's stack, so more than about 1.5M cells overflow a stack of 8 MB
+  template<int W, int H>
+  constexpr FixedGrid<W, H> GenerateFixed(std::uint64_t seed)
+  {
+    FixedGrid<W, H> grid;
+    Random random(seed);
+
+    std::array<std::uint32_t, std::size_t(W) * H> path{};
+    std::int64_t pathSize = 1;
+    std::int64_t visitedCells = 1;
+
+    int x = 0;
+    int y = 0;
+    std::int64_t index = 0;
+    grid.MarkVisited(0);
+
+    while (visitedCells < grid.CellCount())
+    {
+      // A neighbour is valid if it exists and has not been visited
+      NeighbourMask neighbours = NeighbourMask(
+        (y > 0 and not grid.IsVisited(index - W)) * MaskOf(UP) |
+        (x > 0 and not grid.IsVisited(index - 1)) * MaskOf(LEFT) |
+        (y < H - 1 and not grid.IsVisited(index + W)) * MaskOf(DOWN) |
+        (x < W - 1 and not grid.IsVisited(index + 1)) * MaskOf(RIGHT)
+      );
+
+      if (neighbours != 0)
+      {
+        Direction direction = NthOf(neighbours, random.Uniform(CountOf(neighbours)));
+
+        grid.Carve(index, direction);
+
+        switch (direction)
+        {
+          case UP: y--; index -= W; break;
+          case LEFT: x--; index--; break;
+          case DOWN: y++; index += W; break;
+          case RIGHT: x++; index++; break;
+          default: break;
+        }
+
+        path[pathSize++] = std::uint32_t(index);
+        visitedCells++;
+      }
+      // Backtracking, the coordinates of the new top of the stack fold into a shift if W is a power of two
+      else
+      {
+        pathSize--;
+        index = path[pathSize - 1];
+        x = int(index % W);
+        y = int(index / W);
+      }
+    }
+
+    return grid;
+  }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "maze/Direction.h"
+#include "maze/PackedGrid.h"
+#include "maze/Random.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace maze
+{
+  // A passage opened by a generator, from the cell at index towards direction
+  struct Carving
+  {
+    std::int64_t index = -1;
+    Direction direction = NOT_SET; // NOT_SET if nothing has been opened
+  };
+
+  // Common interface of all maze generation algorithms
+  // A generator works on a grid it does not own, every Step() opens at most one passage so it can be animated
+  template<typename Grid>
+  class Generator
+  {
+  public:
+    explicit Generator(Grid& grid) : grid(grid) {}
+    virtual ~Generator() = default;
+
+    // Clears the grid and starts a new maze, the same seed always produces the same maze
+    virtual void Reset(std::uint64_t seed) = 0;
+
+    // Advances the maze by one unit of work
+    // Returns false if there was nothing left to do
+    virtual bool Step() = 0;
+
+    // Generates the rest of the maze in one go
+    virtual void Run() { while (Step()); }
+
+    virtual bool IsDone() const = 0;
+
+    // The cell the algorithm is working on, if it has such a thing, only valid if HasCurrentCell() is true
+    virtual bool HasCurrentCell() const { return false; }
+    virtual Point CurrentCell() const { return Point{0, 0}; }
+
+    // Heap memory the algorithm needs besides the grid in bytes, at its peak
+    virtual std::size_t MemoryUsage() const = 0;
+
+    // The passage opened by the last step
+    Carving LastCarving() const { return lastCarving; }
+
+    std::uint64_t Seed() const { return seed; }
+
+  protected:
+    Grid& grid;
+    Random random; // Owned by this generator alone
+    std::uint64_t seed = 0; // Seed of the current maze
+    Carving lastCarving;
+
+    // Seeds the random number generator and clears the grid
+    void Restart(std::uint64_t seed)
+    {
+      grid.Clear();
+
+      this->seed = seed;
+      random.Seed(seed);
+      lastCarving = Carving();
+    }
+
+    // Opens a passage through the grid and remembers it
+    void Carve(std::int64_t index, Direction direction)
+    {
+      grid.Carve(index, direction);
+      lastCarving = Carving{index, direction};
+    }
+  };
+
+  // Names of all algorithms MakeGenerator knows, the first one is the default
+  const std::vector<std::string>& GeneratorNames();
+
+  // Creates the generator with the given name working on grid, or returns nullptr if there is no such algorithm
+  std::unique_ptr<Generator<PackedGrid>> MakeGenerator(const std::string& name, PackedGrid& grid);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "maze/Generator.h"
+#include "maze/PackedGrid.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace maze
+{
+  // Growing tree: keeps a list of active cells, extends one of them into an unvisited neighbour and retires it once it has none
+  // Always picking the newest cell behaves like the backtracker, always picking a random one like Prim
+  class GrowingTree final : public Generator<PackedGrid>
+  {
+  public:
+    // newestChance is the probability of extending the newest active cell instead of a random one
+    explicit GrowingTree(PackedGrid& grid, float newestChance = 0.5f);
+
+    // Starts the maze in the top leftmost cell
+    void Reset(std::uint64_t seed) override;
+
+    // Extends or retires one active cell
+    bool Step() override;
+
+    void Run() override;
+
+    bool IsDone() const override { return activeCells.empty(); }
+
+    // The cell that has been extended or retired last
+    bool HasCurrentCell() const override { return currentCell >= 0; }
+    Point CurrentCell() const override { return grid.Coordinates(currentCell); }
+
+    std::size_t MemoryUsage() const override { return peakActiveCells * sizeof(std::int64_t); }
+
+  private:
+    std::uint32_t newestThreshold; // Random numbers below this pick the newest cell
+    std::vector<std::int64_t> activeCells; // Cells that might still have unvisited neighbours in the order they became active, newest last
+    std::size_t retiredCount = 0; // Retired cells left in activeCells as -1 until it gets compacted, the newest cell is never one of them
+    std::size_t peakActiveCells = 0;
+    std::int64_t currentCell = -1;
+  };
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "maze/Deflate.h"
+#include "maze/EllerStream.h"
+#include "maze/PackedGrid.h"
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace maze
+{
+  // Draws a maze into a black and white PNG one row at a time, paths are white and walls black
+  // Each cell is pathWidth pixels wide with a pixel of wall around it, the same as in the window
+  // Pixel rows are deflated as soon as they are drawn, so memory only depends on the width of the maze and never on its height
+  // The pixel rows inside a row of cells are all the same, only the first one is drawn and compressed, the others refer back to it
+  class MazeImage
+  {
+  public:
+    // Writes the PNG header and the top border of a maze of width x height cells
+    // Throws std::invalid_argument if the image would be larger than a PNG can be
+    MazeImage(std::ostream& output, int width, int height, int pathWidth = 3);
+
+    MazeImage(const MazeImage&) = delete;
+    MazeImage& operator=(const MazeImage&) = delete;
+
+    // Draws the next row, one bit per cell in words of 64 cells as PackedGrid::ReadRow() hands them out
+    // Rows have to come from top to bottom, the image is finished after the last one
+    void AddRow(const std::uint64_t* openRight, const std::uint64_t* openDown);
+    void AddRow(const MazeRow& row) { AddRow(row.OpenRightBits(), row.OpenDownBits()); }
+
+    int RowCount() const { return rowCount; }
+
+  private:
+    std::ostream& output;
+    int width;
+    int height;
+    int pathWidth;
+    int rowCount = 0;
+    std::size_t lineLength; // Filter byte and pixels of one pixel row, 8 pixels per byte
+    std::vector<std::uint8_t> line; // A pixel row with room to spare, Draw() writes 8 bytes at a time
+    std::vector<std::uint64_t> openLeft; // Bits of the row shifted by one cell, a cell draws the wall to its left
+    std::vector<std::uint8_t> cellPatterns; // Pixels of 8 cells for every combination of their bits, pathWidth + 1 bytes used out of 8
+    std::vector<std::uint8_t> wallPatterns;
+    LineDeflater deflater; // Writes the image data chunks
+
+    // Sets the pixels of line from one bit per cell, a cell draws pathWidth + 1 pixels of set if its bit is 1 and of clear otherwise
+    // The wall to the left of a cell comes first, the pixel of the right border is closed afterwards
+    void Draw(const std::uint64_t* cells, const std::vector<std::uint8_t>& patterns, std::uint64_t set, std::uint64_t clear);
+
+    // Pixels of a cell in a row of cells, the wall to its left and its inside
+    std::uint64_t CellPixels(bool isOpenLeft) const { return std::uint64_t(isOpenLeft) << pathWidth | ((std::uint64_t(1) << pathWidth) - 1); }
+
+    // Pixels of a cell in a row of walls, the corner to its left and the wall below it
+    std::uint64_t WallPixels(bool isOpenDown) const { return isOpenDown ? (std::uint64_t(1) << pathWidth) - 1 : 0; }
+
+    void WriteChunk(const char* type, const std::uint8_t* data, std::size_t length);
+  };
+
+  // Draws a whole maze as a PNG
+  void WritePng(const PackedGrid& grid, std::ostream& output, int pathWidth = 3);
+}
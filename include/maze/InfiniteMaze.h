@@ -0,0 +1,83 @@
+#pragma once
+
+#include "maze/Direction.h"
+#include "maze/PackedGrid.h"
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace maze
+{
+  // The passage a chunk opens through its border, into the chunk above or the one to its left
+  struct ChunkExit
+  {
+    Direction direction; // UP or LEFT
+    int position; // Column of the passage if it leads up, row if it leads left
+  };
+
+  // A maze without borders, cut into square chunks that are generated on demand
+  // A chunk only depends on the seed, the chunk size, the algorithm and its own coordinates, so any part of the maze can be looked at without generating what lies around it
+  // Inside, every chunk is a perfect maze of its own, its border is closed except for a single exit into the chunk above or to the left (the binary tree algorithm on chunks)
+  // Both chunks next to a border can work out its passage from the coordinates alone, and since exits only lead up and left, the chunks form a tree and the whole maze has no loops
+  class InfiniteMaze
+  {
+  public:
+    // Keeps the last cacheCapacity chunks that were looked at
+    // Throws std::invalid_argument if the chunk size or the capacity is smaller than 1 or there is no such algorithm
+    InfiniteMaze(std::uint64_t seed, int chunkSize = 64, const std::string& algorithm = "backtracker", std::size_t cacheCapacity = 256);
+
+    std::uint64_t Seed() const { return seed; }
+    int ChunkSize() const { return chunkSize; }
+
+    // Generates the inside of a chunk without looking at the cache, the same coordinates always give the same chunk
+    PackedGrid GenerateChunk(std::int64_t chunkX, std::int64_t chunkY) const;
+
+    // The exit of a chunk, which does not need the chunk to be generated
+    ChunkExit Exit(std::int64_t chunkX, std::int64_t chunkY) const;
+
+    // The inside of a chunk from the cache, a chunk that is not in there is generated and replaces the least recently used one if the cache is full
+    // The reference stays valid until the next call of Chunk() or IsPassage()
+    const PackedGrid& Chunk(std::int64_t chunkX, std::int64_t chunkY);
+
+    // Returns true if there is a passage between the cell at x and y and its neighbour, the coordinates count cells from anywhere in the plane
+    bool IsPassage(std::int64_t x, std::int64_t y, Direction direction);
+
+    // The chunk a cell coordinate lies in, rounding towards negative infinity
+    std::int64_t ChunkOf(std::int64_t cell) const { return (cell >= 0 ? cell : cell - chunkSize + 1) / chunkSize; }
+
+    std::size_t CachedChunks() const { return chunks.size(); }
+    std::int64_t CacheHits() const { return cacheHits; }
+    std::int64_t CacheMisses() const { return cacheMisses; }
+
+  private:
+    struct CachedChunk
+    {
+      std::int64_t x;
+      std::int64_t y;
+      PackedGrid grid;
+    };
+
+    struct ChunkKeyHash
+    {
+      std::size_t operator()(const std::pair<std::int64_t, std::int64_t>& key) const
+      {
+        return std::hash<std::int64_t>()(key.first * 0x9e3779b97f4a7c15 ^ key.second);
+      }
+    };
+
+    std::uint64_t seed;
+    int chunkSize;
+    std::string algorithm;
+    std::size_t cacheCapacity;
+
+    std::list<CachedChunk> chunks; // Most recently used first
+    std::unordered_map<std::pair<std::int64_t, std::int64_t>, std::list<CachedChunk>::iterator, ChunkKeyHash> cachedChunks; // Where a chunk is in chunks
+    std::int64_t cacheHits = 0;
+    std::int64_t cacheMisses = 0;
+
+    // Seed of everything random about a chunk
+    std::uint64_t ChunkSeed(std::int64_t chunkX, std::int64_t chunkY) const;
+  };
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "maze/Generator.h"
+#include "maze/PackedGrid.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace maze
+{
+  // Randomized Kruskal: visits every wall in random order and opens it if the cells on both sides are not connected yet
+  // The walls are enumerated through a keyed permutation instead of a shuffled list, so the only extra memory is the union-find forest
+  class Kruskal final : public Generator<PackedGrid>
+  {
+  public:
+    explicit Kruskal(PackedGrid& grid);
+
+    void Reset(std::uint64_t seed) override;
+
+    // Looks at the next wall
+    bool Step() override;
+
+    void Run() override;
+
+    bool IsDone() const override { return carvedPassages >= grid.CellCount() - 1 or nextWall >= wallCount; }
+
+    std::size_t MemoryUsage() const override { return parents.capacity() * sizeof(std::uint32_t); }
+
+  private:
+    std::vector<std::uint32_t> parents; // Union-find forest over the cells
+    std::int64_t wallCount; // Walls between two cells, numbered index * 2 (right) and index * 2 + 1 (down)
+    std::int64_t nextWall = 0; // Position in the permutation of the walls
+    std::int64_t carvedPassages = 0;
+    int permutationHalfBits = 0; // Each half of the Feistel network works on this many bits
+    std::uint64_t permutationKeys[4]; // Round keys of the Feistel network
+
+    // Returns the root of the tree the cell belongs to, halving the path along the way
+    std::uint32_t Find(std::uint32_t cell);
+
+    // Maps position onto a wall so that every wall comes up exactly once
+    std::uint64_t PermutedWall(std::uint64_t position) const;
+  };
+}
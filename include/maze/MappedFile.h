@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace maze
+{
+  // A file mapped into memory for reading and writing, the operating system pages it in and out on its own
+  // That way data larger than the physical memory can be worked on as if it was an array
+  // Uses mmap on POSIX systems and file mappings on Windows, errors throw std::runtime_error
+  class MappedFile
+  {
+  public:
+    // How the mapping is going to be accessed, lets the operating system read ahead and drop pages that are behind
+    enum Access
+    {
+      NORMAL,
+      SEQUENTIAL,
+      RANDOM
+    };
+
+    // Whether the mapping can be written to, writing to a read-only mapping crashes
+    enum Mode
+    {
+      READ_WRITE,
+      READ_ONLY
+    };
+
+    // Opens the file, creating it if it does not exist, makes it exactly size bytes long and maps all of it
+    // Bytes the file did not have before read as 0
+    MappedFile(const std::filesystem::path& path, std::size_t size);
+
+    // Opens and maps an existing file with the size it has
+    explicit MappedFile(const std::filesystem::path& path, Mode mode = READ_WRITE);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::uint8_t* Data() { return data; }
+    const std::uint8_t* Data() const { return data; }
+    std::size_t Size() const { return size; }
+
+    // A hint for the whole mapping, it is ignored where the system has no such thing
+    void Advise(Access access);
+
+    // Writes the changed pages in the range back to the file, waiting for the disk if wait is true
+    void Flush(std::size_t offset, std::size_t length, bool wait);
+    void Flush(bool wait) { Flush(0, size, wait); }
+
+    // Writes the range back and lets the operating system drop it from memory, reading it again pages it back in from the file
+    void Evict(std::size_t offset, std::size_t length);
+
+    // Sets the range to 0, whole pages are cut out of the file instead of being written where the file system supports it
+    void Zero(std::size_t offset, std::size_t length);
+
+  private:
+    std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+
+#if defined(_WIN32)
+    void* file = nullptr;
+    void* mapping = nullptr;
+#else
+    int descriptor = -1;
+#endif
+
+    void Open(const std::filesystem::path& path, Mode mode, bool resize, std::size_t newSize);
+  };
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "maze/Direction.h"
+#include "maze/NeighbourMask.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace maze
+{
+  namespace detail
+  {
+    // Every byte with its bits moved apart so that there is a zero bit between every two of them
+    constexpr std::array<std::uint16_t, 256> BuildSpreadTable()
+    {
+      std::array<std::uint16_t, 256> table{};
+
+      for (int byte = 0; byte < 256; byte++)
+      {
+        for (int bit = 0; bit < 8; bit++)
+        {
+          table[byte] |= std::uint16_t(((byte >> bit) & 1) << (2 * bit));
+        }
+      }
+
+      return table;
+    }
+
+    inline constexpr std::array<std::uint16_t, 256> spreadTable = BuildSpreadTable();
+  }
+
+  // The same three bits per cell as PackedGrid, but the cells are stored along a Z-order (Morton) curve instead of row by row
+  // Cells that are close in the maze are close in memory in both directions, so walking up or down stays within a few cache lines
+  // The bits of x and y are interleaved as far as the smaller side reaches, the remaining bits of the larger side sit on top
+  // Every side is padded to a power of two, the padding cells are never visited and cost 3 bits each
+  class MortonGrid
+  {
+  public:
+    // Throws std::invalid_argument if a side is smaller than 1 or the padded grid has more than 2^32 cells
+    MortonGrid(int width, int height);
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+    std::int64_t CellCount() const { return std::int64_t(width) * height; }
+
+    std::int64_t Index(int x, int y) const
+    {
+      std::uint64_t low = Spread(std::uint32_t(x) & lowMask) | Spread(std::uint32_t(y) & lowMask) << 1;
+
+      // Only the larger side has bits above the interleaved ones
+      return std::int64_t(low | std::uint64_t((std::uint32_t(x) | std::uint32_t(y)) >> commonBits) << (2 * commonBits));
+    }
+
+    Point Coordinates(std::int64_t index) const;
+
+    bool IsVisited(std::int64_t index) const { return Bit(index, VISITED); }
+    void MarkVisited(std::int64_t index) { SetBit(index, VISITED); }
+
+    // Opens the wall between the cell and its neighbour and marks the neighbour as visited
+    void Carve(std::int64_t index, Direction direction);
+
+    bool IsOpenRight(std::int64_t index) const { return Bit(index, OPEN_RIGHT); }
+    bool IsOpenDown(std::int64_t index) const { return Bit(index, OPEN_DOWN); }
+
+    // Returns the index of the neighbour towards direction, which has to lie inside the maze
+    // x and y are counted up or down in place on their own bits, the carry runs through the bits of the other coordinate
+    std::int64_t Neighbour(std::int64_t index, Direction direction) const
+    {
+      std::uint64_t i = std::uint64_t(index);
+
+      switch (direction)
+      {
+        case UP: return std::int64_t((((i & yMask) - 1) & yMask) | (i & xMask));
+        case LEFT: return std::int64_t((((i & xMask) - 1) & xMask) | (i & yMask));
+        case DOWN: return std::int64_t((((i | xMask) + 1) & yMask) | (i & xMask));
+        case RIGHT: return std::int64_t((((i | yMask) + 1) & xMask) | (i & yMask));
+        default: return index;
+      }
+    }
+
+    // Returns true if the neighbour of the cell at x and y lies inside the maze
+    bool HasNeighbour(int x, int y, Direction direction) const;
+
+    // Returns every direction whose neighbour lies inside the maze
+    NeighbourMask Neighbours(int x, int y) const
+    {
+      return NeighbourMask((y > 0) * MaskOf(UP) | (x > 0) * MaskOf(LEFT) | (y < height - 1) * MaskOf(DOWN) | (x < width - 1) * MaskOf(RIGHT));
+    }
+
+    // Returns true if there is a passage between the cell at x and y and its neighbour
+    bool IsPassage(int x, int y, Direction direction) const;
+
+    // Returns true if the cell at x and y is closed off towards direction, the border counts as a wall
+    bool HasWall(int x, int y, Direction direction) const { return not IsPassage(x, y, direction); }
+
+    // Closes every wall and marks every cell as unvisited
+    void Clear();
+
+    // Heap memory used by the bits in bytes, including the padding
+    std::size_t MemoryUsage() const { return words.capacity() * sizeof(std::uint64_t); }
+
+  private:
+    // Offsets of the three words of a block of 64 cells
+    enum Plane
+    {
+      OPEN_RIGHT,
+      OPEN_DOWN,
+      VISITED,
+      PLANE_COUNT
+    };
+
+    int width;
+    int height;
+    int commonBits; // Number of bits of x and y that are interleaved
+    std::uint32_t lowMask; // The interleaved bits of a coordinate
+    std::uint64_t xMask; // Bits of an index that belong to x
+    std::uint64_t yMask; // Bits of an index that belong to y
+    std::vector<std::uint64_t> words;
+
+    // Moves the bits of a coordinate to the even bits of the result, one table lookup per byte
+    static std::uint64_t Spread(std::uint32_t value)
+    {
+      return std::uint64_t(detail::spreadTable[value & 255]) |
+        std::uint64_t(detail::spreadTable[(value >> 8) & 255]) << 16 |
+        std::uint64_t(detail::spreadTable[(value >> 16) & 255]) << 32 |
+        std::uint64_t(detail::spreadTable[value >> 24]) << 48;
+    }
+
+    // The reverse of Spread(), takes the even bits of value
+    static std::uint32_t Compact(std::uint64_t value);
+
+    bool Bit(std::int64_t index, Plane plane) const
+    {
+      return (words[(index >> 6) * PLANE_COUNT + plane] >> (index & 63)) & 1;
+    }
+
+    void SetBit(std::int64_t index, Plane plane)
+    {
+      words[(index >> 6) * PLANE_COUNT + plane] |= std::uint64_t(1) << (index & 63);
+    }
+  };
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "maze/Direction.h"
+
+#include <array>
+#include <cstdint>
+
+namespace maze
+{
+  // A set of directions packed into 4 bits, bit (direction - 1) being set if the direction is part of it
+  // Picking a random member is a table lookup instead of building a container on every step
+  using NeighbourMask = std::uint8_t;
+
+  constexpr NeighbourMask MaskOf(Direction direction)
+  {
+    return NeighbourMask(1u << (direction - 1));
+  }
+
+  namespace detail
+  {
+    struct NeighbourMaskTables
+    {
+      std::array<std::uint8_t, 16> count{}; // Number of directions in a mask
+      std::array<std::array<Direction, 4>, 16> nth{}; // The n-th direction of a mask, ordered UP, LEFT, DOWN, RIGHT
+    };
+
+    constexpr NeighbourMaskTables BuildNeighbourMaskTables()
+    {
+      NeighbourMaskTables tables;
+
+      for (int mask = 0; mask < 16; mask++)
+      {
+        for (int direction = UP; direction <= RIGHT; direction++)
+        {
+          if (mask & MaskOf(Direction(direction)))
+          {
+            tables.nth[mask][tables.count[mask]++] = Direction(direction);
+          }
+        }
+      }
+
+      return tables;
+    }
+
+    inline constexpr NeighbourMaskTables neighbourMaskTables = BuildNeighbourMaskTables();
+  }
+
+  // Number of directions in the mask
+  constexpr int CountOf(NeighbourMask mask)
+  {
+    return detail::neighbourMaskTables.count[mask];
+  }
+
+  // The n-th direction in the mask, n has to be smaller than CountOf(mask)
+  constexpr Direction NthOf(NeighbourMask mask, int n)
+  {
+    return detail::neighbourMaskTables.nth[mask][n];
+  }
+}
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "maze/Direction.h"
+#include "maze/MappedFile.h"
+#include "maze/NeighbourMask.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace maze
+{
+  // The cells of a block of 64 that have a passage towards each direction, one bit per cell
+  struct BlockPassages
+  {
+    std::uint64_t up;
+    std::uint64_t left;
+    std::uint64_t down;
+    std::uint64_t right;
+  };
+
+  // A row-major grid that stores three bits per cell: "open to the right", "open downwards" and "visited"
+  // Walls to the left and above a cell are the right and lower walls of its neighbours
+  // The bits of 64 consecutive cells are kept next to each other as three words (right, down, visited)
+  // The words live on the heap or in a memory mapped file, which lets a maze grow past the physical memory
+  class PackedGrid
+  {
+  public:
+    PackedGrid(int width, int height);
+
+    // A copy always lives on the heap
+    PackedGrid(const PackedGrid& other);
+    PackedGrid& operator=(const PackedGrid& other);
+    PackedGrid(PackedGrid&& other) = default;
+    PackedGrid& operator=(PackedGrid&& other) = default;
+
+    // Keeps the words in a file instead of the heap, the file is created or overwritten with an empty maze
+    // Throws std::runtime_error if the file can not be created or mapped
+    static PackedGrid CreateMapped(const std::filesystem::path& path, int width, int height);
+
+    // Maps a file written through CreateMapped() again, the maze can then be read (and changed unless it is mapped READ_ONLY) without loading it
+    // Throws std::runtime_error if the file can not be mapped or is no such file
+    static PackedGrid OpenMapped(const std::filesystem::path& path, MappedFile::Mode mode = MappedFile::READ_WRITE);
+
+    // Whether the file starts like one written through CreateMapped(), which tells it apart from the binary maze format
+    static bool IsMappedFile(const std::filesystem::path& path);
+
+    int Width() const { return width; }
+    int Height() const { return height; }
+    std::int64_t CellCount() const { return std::int64_t(width) * height; }
+
+    std::int64_t Index(int x, int y) const { return std::int64_t(y) * width + x; }
+    Point Coordinates(std::int64_t index) const { return Point{int(index % width), int(index / width)}; }
+
+    bool IsVisited(std::int64_t index) const { return Bit(index, VISITED); }
+    void MarkVisited(std::int64_t index) { SetBit(index, VISITED); }
+
+    // Opens the wall between the cell and its neighbour and marks the neighbour as visited
+    void Carve(std::int64_t index, Direction direction);
+
+    bool IsOpenRight(std::int64_t index) const { return Bit(index, OPEN_RIGHT); }
+    bool IsOpenDown(std::int64_t index) const { return Bit(index, OPEN_DOWN); }
+
+    // The same bits for the 64 cells starting at index at once, cells past the end of the grid read as 0
+    std::uint64_t OpenRightBits(std::int64_t index) const { return Bits(index, OPEN_RIGHT); }
+    std::uint64_t OpenDownBits(std::int64_t index) const { return Bits(index, OPEN_DOWN); }
+
+    // Number of blocks of 64 cells, the last one may be cut off
+    std::int64_t BlockCount() const { return (CellCount() + 63) / 64; }
+
+    // The passages of the cells index * 64 to index * 64 + 63 towards each direction, for looking at many cells at once
+    BlockPassages PassagesOfBlock(std::int64_t block) const
+    {
+      const std::int64_t first = block * 64;
+
+      BlockPassages passages;
+      passages.right = Bits(first, OPEN_RIGHT);
+      passages.down = Bits(first, OPEN_DOWN);
+
+      // A cell is open to the left if the cell before it is open to the right, the last cell of a row never is
+      passages.left = passages.right << 1 | std::uint64_t(first > 0 and IsOpenRight(first - 1));
+
+      // It is open upwards if the cell above it is open downwards, the cells of the first row have none above them
+      if (first >= width)
+      {
+        passages.up = Bits(first - width, OPEN_DOWN);
+      }
+      else
+      {
+        passages.up = first + 64 > width ? Bits(0, OPEN_DOWN) << (width - first) : 0;
+      }
+
+      return passages;
+    }
+
+    // Returns every direction the cell has a passage towards
+    NeighbourMask Passages(std::int64_t index) const
+    {
+      return NeighbourMask((index >= width and IsOpenDown(index - width)) * MaskOf(UP) | (index > 0 and IsOpenRight(index - 1)) * MaskOf(LEFT) | IsOpenDown(index) * MaskOf(DOWN) | IsOpenRight(index) * MaskOf(RIGHT));
+    }
+
+    // Returns the index of the neighbour towards direction, which has to lie inside the maze
+    std::int64_t Neighbour(std::int64_t index, Direction direction) const
+    {
+      switch (direction)
+      {
+        case UP: return index - width;
+        case LEFT: return index - 1;
+        case DOWN: return index + width;
+        case RIGHT: return index + 1;
+        default: return index;
+      }
+    }
+
+    // Returns true if the neighbour of the cell at x and y lies inside the maze
+    bool HasNeighbour(int x, int y, Direction direction) const;
+
+    // Returns every direction whose neighbour lies inside the maze
+    NeighbourMask Neighbours(int x, int y) const
+    {
+      return NeighbourMask((y > 0) * MaskOf(UP) | (x > 0) * MaskOf(LEFT) | (y < height - 1) * MaskOf(DOWN) | (x < width - 1) * MaskOf(RIGHT));
+    }
+
+    // Returns every direction whose neighbour lies inside the maze and has (or has not) been visited
+    NeighbourMask VisitedNeighbours(std::int64_t index, bool visited) const
+    {
+      Point cell = Coordinates(index);
+      NeighbourMask neighbours = Neighbours(cell.x, cell.y);
+      NeighbourMask result = 0;
+
+      for (int direction = UP; direction <= RIGHT; direction++)
+      {
+        if ((neighbours & MaskOf(Direction(direction))) and IsVisited(Neighbour(index, Direction(direction))) == visited)
+        {
+          result |= MaskOf(Direction(direction));
+        }
+      }
+
+      return result;
+    }
+
+    // Returns true if there is a passage between the cell at x and y and its neighbour
+    bool IsPassage(int x, int y, Direction direction) const;
+
+    // Returns true if the cell at x and y is closed off towards direction, the border counts as a wall
+    bool HasWall(int x, int y, Direction direction) const { return not IsPassage(x, y, direction); }
+
+    // Closes every wall and marks every cell as unvisited
+    void Clear();
+
+    // Adds the passages and visited cells of a smaller grid, placing its top left cell at x and y
+    // Tiles that do not overlap can be merged from several threads at once, words that two tiles share are combined atomically
+    void MergeTile(const PackedGrid& tile, int x, int y);
+
+    // Copies the passages of row y out, one bit per cell in words of 64 cells, bits past the width are 0
+    void ReadRow(int y, std::uint64_t* openRight, std::uint64_t* openDown) const;
+
+    // Adds the passages of row y in the layout ReadRow() uses and marks every cell of the row as visited
+    void WriteRow(int y, const std::uint64_t* openRight, const std::uint64_t* openDown);
+
+    // Memory used by the bits in bytes, on the heap or in the file
+    std::size_t MemoryUsage() const { return wordCount * sizeof(std::uint64_t); }
+
+    // The file the words are kept in, nullptr if they are on the heap
+    MappedFile* Mapping() { return mapping.get(); }
+
+    // Writes the rows before endRow back to the file and lets them drop out of memory, for generators that finish the maze from top to bottom
+    // Does nothing on the heap, rows that have been evicted before are skipped
+    void EvictRowsBefore(int endRow);
+
+  private:
+    // Offsets of the three words of a block of 64 cells
+    enum Plane
+    {
+      OPEN_RIGHT,
+      OPEN_DOWN,
+      VISITED,
+      PLANE_COUNT
+    };
+
+    int width;
+    int height;
+    std::vector<std::uint64_t> heapWords; // The words if they live on the heap
+    std::unique_ptr<MappedFile> mapping; // The file the words live in otherwise
+    std::uint64_t* words = nullptr; // Points into one of the two
+    std::size_t wordCount = 0;
+    std::size_t evictedBytes = 0; // Bytes of the file that EvictRowsBefore() has already handed back
+
+    // Maps the file as the storage of the words, which start after a header
+    PackedGrid(int width, int height, std::unique_ptr<MappedFile> mapping);
+
+    bool Bit(std::int64_t index, Plane plane) const
+    {
+      return (words[(index >> 6) * PLANE_COUNT + plane] >> (index & 63)) & 1;
+    }
+
+    void SetBit(std::int64_t index, Plane plane)
+    {
+      words[(index >> 6) * PLANE_COUNT + plane] |= std::uint64_t(1) << (index & 63);
+    }
+
+    // The bits of the 64 cells starting at index, cells past the end of the grid read as 0
+    std::uint64_t Bits(std::int64_t index, Plane plane) const
+    {
+      std::size_t word = (index >> 6) * PLANE_COUNT + plane;
+      int shift = index & 63;
+
+      std::uint64_t bits = words[word] >> shift;
+
+      if (shift != 0 and word + PLANE_COUNT < wordCount)
+      {
+        bits |= words[word + PLANE_COUNT] << (64 - shift);
+      }
+
+      return bits;
+    }
+
+    // Sets the given bits of the 64 cells starting at index with atomic operations
+    void SetBitsAtomically(std::int64_t index, Plane plane, std::uint64_t bits);
+  };
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "maze/Generator.h"
+#include "maze/PackedGrid.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace maze
+{
+  // Randomized Prim: grows the maze from one cell by attaching a random cell of its frontier to a random visited neighbour
+  class Prim final : public Generator<PackedGrid>
+  {
+  public:
+    explicit Prim(PackedGrid& grid);
+
+    // Starts the maze in the top leftmost cell
+    void Reset(std::uint64_t seed) override;
+
+    // Attaches one frontier cell to the maze
+    bool Step() override;
+
+    void Run() override;
+
+    bool IsDone() const override { return frontier.empty(); }
+
+    // The cell that has been attached last
+    bool HasCurrentCell() const override { return currentCell >= 0; }
+    Point CurrentCell() const override { return grid.Coordinates(currentCell); }
+
+    std::size_t MemoryUsage() const override { return peakFrontierSize * sizeof(std::int64_t) + (isInFrontier.capacity() + 7) / 8; }
+
+  private:
+    std::vector<std::int64_t> frontier; // Unvisited cells next to the maze, in no particular order
+    std::vector<bool> isInFrontier;
+    std::size_t peakFrontierSize = 0;
+    std::int64_t currentCell = -1;
+
+    // Adds the unvisited neighbours of the cell to the frontier
+    void AddNeighboursToFrontier(std::int64_t index);
+  };
+}
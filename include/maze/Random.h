@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace maze
+{
+  // xoshiro256** pseudo random number generator (Blackman & Vigna)
+  // Every generator owns its own instance, so mazes can be reproduced from their seed and generated on many threads at once
+  // It satisfies UniformRandomBitGenerator and can therefore also be plugged into the distributions of <random>
+  // Everything is constexpr, so mazes can also be generated at compile time
+  class Random
+  {
+  public:
+    using result_type = std::uint64_t;
+
+    constexpr explicit Random(std::uint64_t seed = 0) { Seed(seed); }
+
+    // Expands the seed into the 256 bit state with splitmix64, so that similar seeds give unrelated sequences
+    constexpr void Seed(std::uint64_t seed)
+    {
+      for (std::uint64_t& word : state)
+      {
+        seed += 0x9e3779b97f4a7c15;
+
+        std::uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        word = z ^ (z >> 31);
+      }
+    }
+
+    constexpr std::uint64_t operator()()
+    {
+      std::uint64_t result = RotateLeft(state[1] * 5, 7) * 9;
+      std::uint64_t t = state[1] << 17;
+
+      state[2] ^= state[0];
+      state[3] ^= state[1];
+      state[1] ^= state[2];
+      state[0] ^= state[3];
+
+      state[2] ^= t;
+      state[3] = RotateLeft(state[3], 45);
+
+      return result;
+    }
+
+    // Returns a number in [0, bound) without a division (Lemire's multiply and shift)
+    constexpr std::uint32_t Uniform(std::uint32_t bound)
+    {
+      return std::uint32_t(((*this)() >> 32) * bound >> 32);
+    }
+
+    static constexpr std::uint64_t min() { return 0; }
+    static constexpr std::uint64_t max() { return std::numeric_limits<std::uint64_t>::max(); }
+
+  private:
+    std::uint64_t state[4] = {};
+
+    static constexpr std::uint64_t RotateLeft(std::uint64_t x, int k)
+    {
+      return (x << k) | (x >> (64 - k));
+    }
+  };
+
+  // A seed from std::random_device mixed with the clock, for when the user does not ask for a specific one
+  std::uint64_t RandomSeed();
+}
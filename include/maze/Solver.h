@@ -0,0 +1,52 @@
+#pragma once
+
+#include "maze/Direction.h"
+#include "maze/PackedGrid.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace maze
+{
+  // The way a solver found from the start to the goal
+  struct Solution
+  {
+    std::vector<std::int64_t> path; // Indices of the cells from the start to the goal, both included, empty if the goal can not be reached
+    std::int64_t expandedCells = 0; // Cells the solver had to look at to find the path
+    std::size_t memoryUsage = 0; // Bytes the solver needed besides the grid and the path
+
+    // Steps from the start to the goal, -1 if there is no path
+    std::int64_t Length() const { return std::int64_t(path.size()) - 1; }
+  };
+
+  // Breadth first search that expands a whole level at once, the frontier is a bitset laid out like the grid's blocks of 64 cells
+  // Every block of the frontier is moved in all four directions with a few shifts and masks of the passage bits, however many of its cells are set
+  // Instead of a parent per cell it keeps the distance modulo 3, the path is then found backwards from the goal by always stepping to the cell one closer
+  // Always finds a shortest path, 5 bits per cell
+  Solution SolveBreadthFirst(const PackedGrid& grid, Point start, Point goal);
+
+  // A* with the Manhattan distance, the open cells are kept in a binary heap of single 64 bit keys (priority above the cell's index)
+  // The distance walked so far is not stored but follows from the priority, the cell's parent takes 2 bits per cell
+  // It is the textbook baseline the other two solvers are measured against and never the fastest of them:
+  // in a perfect maze the way between two cells winds far away from the straight line, so the estimate prunes next to nothing,
+  // it expands about as many cells as breadth first search (even for cells a few steps apart) and pays a heap operation for each of them
+  // A cell is only ever added once, which finds the shortest path in a perfect maze and some path in a maze with loops, 3 bits per cell
+  // Throws std::invalid_argument if the maze has 2^31 cells or more
+  Solution SolveAStar(const PackedGrid& grid, Point start, Point goal);
+
+  // Fills every dead end but the start and the goal, and then every cell that became one, until only the path is left
+  // Dead ends are found 64 cells at a time from the passage bits, each one is then filled until its corridor reaches a junction
+  // The blocks are split into one range per thread, corridors run across the ranges and the filled bits are shared between the threads
+  // Every cell is looked at about once, 1 bit per cell
+  // Only in a perfect maze (every generator makes one) is a single path left over, in a maze with loops the path can come back empty
+  // threadCount 0 uses one thread per hardware thread, small mazes use fewer
+  Solution SolveDeadEndFilling(const PackedGrid& grid, Point start, Point goal, int threadCount = 0);
+
+  // Names of all solvers Solve() knows, the first one is the default
+  const std::vector<std::string>& SolverNames();
+
+  // Finds a path from start to goal with the solver called name, threadCount is handed to the solvers that use threads
+  // Throws std::invalid_argument if there is no such solver or the start or the goal does not lie inside the maze
+  Solution Solve(const std::string& name, const PackedGrid& grid, Point start, Point goal, int threadCount = 0);
+}
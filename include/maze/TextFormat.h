@@ -0,0 +1,71 @@
+#pragma once
+
+#include "maze/BinaryFormat.h"
+#include "maze/CellGrid.h"
+#include "maze/ChunkedGrid.h"
+#include "maze/EllerStream.h"
+#include "maze/FixedMaze.h"
+#include "maze/MortonGrid.h"
+#include "maze/PackedGrid.h"
+
+#include <ostream>
+#include <string>
+
+namespace maze
+{
+  namespace detail
+  {
+    // Works for every grid type, a grid only needs Width(), Height() and IsPassage()
+    template<typename Grid>
+    void WriteGrid(const Grid& grid, std::ostream& output)
+    {
+      std::string line(2 * grid.Width() + 1, '#');
+
+      // The top border
+      output << line << '\n';
+
+      for (int y = 0; y < grid.Height(); y++)
+      {
+        // The cells of this row and the walls between them
+        for (int x = 0; x < grid.Width(); x++)
+        {
+          line[2 * x + 1] = ' ';
+          line[2 * x + 2] = grid.IsPassage(x, y, RIGHT) ? ' ' : '#';
+        }
+
+        output << line << '\n';
+
+        // The walls below the cells of this row
+        for (int x = 0; x < grid.Width(); x++)
+        {
+          line[2 * x + 1] = grid.IsPassage(x, y, DOWN) ? ' ' : '#';
+          line[2 * x + 2] = '#';
+        }
+
+        output << line << '\n';
+      }
+    }
+  }
+
+  // Writes the maze as text, '#' being a wall and ' ' being a path
+  // Every cell and every wall between two cells takes up one character
+  void WriteText(const CellGrid& grid, std::ostream& output);
+  void WriteText(const PackedGrid& grid, std::ostream& output);
+  void WriteText(const MortonGrid& grid, std::ostream& output);
+  void WriteText(const ChunkedGrid& grid, std::ostream& output); // Released pages are written as closed cells
+  void WriteText(const MazeFileRows& rows, std::ostream& output);
+
+  // Only the rows from firstRow to endRow, the last one of them closed towards the rows below like MazeFileRows
+  void WriteText(const PackedGrid& grid, int firstRow, int endRow, std::ostream& output);
+
+  template<int W, int H>
+  void WriteText(const FixedGrid<W, H>& grid, std::ostream& output)
+  {
+    detail::WriteGrid(grid, output);
+  }
+
+  // The same format for a maze that is streamed row by row
+  // The top border is written once, then every row as it is finished
+  void WriteTextTop(int width, std::ostream& output);
+  void WriteTextRow(const MazeRow& row, std::ostream& output);
+}
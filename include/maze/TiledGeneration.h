@@ -0,0 +1,33 @@
+#pragma once
+
+#include "maze/PackedGrid.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace maze
+{
+  // What a single thread of a tiled generation did
+  struct TileWorkerStatistics
+  {
+    std::int64_t tiles = 0; // Number of tiles generated
+    std::int64_t cells = 0; // Number of cells in those tiles
+    double seconds = 0.0; // Time spent generating and merging them
+  };
+
+  struct TiledStatistics
+  {
+    std::vector<TileWorkerStatistics> workers; // One entry per thread
+    double generationSeconds = 0.0; // Wall clock time until every tile has been merged
+    double stitchingSeconds = 0.0; // Wall clock time of joining the tiles
+  };
+
+  // Generates a perfect maze on many threads
+  // The grid is cut into tiles of tileSize x tileSize cells, every thread takes the next free tile, generates a maze inside it with the given algorithm and merges it into the grid
+  // Afterwards the tiles are joined along a random spanning tree of the tile graph, one passage through each seam of that tree
+  // Tile number i uses seed + i, so the maze only depends on the seed and the tile size and never on the number of threads
+  // threadCount 0 uses one thread per hardware thread, algorithm is one of GeneratorNames()
+  // Throws std::invalid_argument if tileSize is smaller than 1 or there is no algorithm with that name
+  TiledStatistics GenerateTiled(PackedGrid& grid, const std::string& algorithm, std::uint64_t seed, int threadCount = 0, int tileSize = 256);
+}
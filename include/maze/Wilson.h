@@ -0,0 +1,45 @@
+#pragma once
+
+#include "maze/Generator.h"
+#include "maze/PackedGrid.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace maze
+{
+  // Wilson: random walks from unvisited cells until they hit the maze, then adds the loop-erased walk to it
+  // Produces uniformly distributed spanning trees, at the price of long walks while the maze is still small
+  class Wilson final : public Generator<PackedGrid>
+  {
+  public:
+    explicit Wilson(PackedGrid& grid);
+
+    // Starts the maze with a random cell
+    void Reset(std::uint64_t seed) override;
+
+    // Takes one step of the walk or adds one cell of the finished walk to the maze
+    bool Step() override;
+
+    void Run() override;
+
+    bool IsDone() const override { return visitedCells >= grid.CellCount(); }
+
+    // The head of the walk, or the cell that is being added to the maze
+    bool HasCurrentCell() const override { return not IsDone(); }
+    Point CurrentCell() const override { return grid.Coordinates(currentCell); }
+
+    std::size_t MemoryUsage() const override { return walkDirections.capacity() * sizeof(Direction); }
+
+  private:
+    std::vector<Direction> walkDirections; // The direction the walk has last left every cell in, overwriting erases loops
+    std::int64_t visitedCells = 0;
+    std::int64_t nextStart = 0; // Cells before this one are all visited
+    std::int64_t walkStart = 0;
+    std::int64_t currentCell = 0;
+    bool isWalking = false; // Whether the walk is searching for the maze or being added to it
+
+    // Moves nextStart to the next unvisited cell and starts a walk there
+    void StartWalk();
+  };
+}
@@ -0,0 +1,1080 @@
+#include "Commands.h"
+
+#include "maze/Analytics.h"
+#include "maze/Backtracker.h"
+#include "maze/BinaryFormat.h"
+#include "maze/BatchGeneration.h"
+#include "maze/CellGrid.h"
+#include "maze/ChunkedGrid.h"
+#include "maze/DistanceField.h"
+#include "maze/DistanceIndex.h"
+#include "maze/Eller.h"
+#include "maze/EllerStream.h"
+#include "maze/FixedMaze.h"
+#include "maze/Generator.h"
+#include "maze/ImageFormat.h"
+#include "maze/InfiniteMaze.h"
+#include "maze/MortonGrid.h"
+#include "maze/PackedGrid.h"
+#include "maze/Solver.h"
+#include "maze/TextFormat.h"
+#include "maze/TiledGeneration.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#if defined(__linux__)
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+// Counts the cache misses of the calling thread with perf_event_open
+// Only available on Linux and only if the kernel lets the process see hardware counters, IsAvailable() tells
+class CacheMissCounter
+{
+public:
+  CacheMissCounter()
+  {
+#if defined(__linux__)
+    perf_event_attr attributes = {};
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+
+    descriptor = int(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+#endif
+  }
+
+  ~CacheMissCounter()
+  {
+#if defined(__linux__)
+    if (descriptor >= 0)
+    {
+      close(descriptor);
+    }
+#endif
+  }
+
+  CacheMissCounter(const CacheMissCounter&) = delete;
+  CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+  bool IsAvailable() const { return descriptor >= 0; }
+
+  void Start()
+  {
+#if defined(__linux__)
+    if (IsAvailable())
+    {
+      ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+      ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  // Returns the misses since Start(), or -1 if there is no counter
+  std::int64_t Stop()
+  {
+    std::int64_t misses = -1;
+
+#if defined(__linux__)
+    if (IsAvailable())
+    {
+      ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+
+      if (read(descriptor, &misses, sizeof(misses)) != sizeof(misses))
+      {
+        misses = -1;
+      }
+    }
+#endif
+
+    return misses;
+  }
+
+private:
+  int descriptor = -1;
+};
+
+// Times one maze on the given grid type and prints a row of the benchmark table
+template<typename Grid>
+static void BenchmarkGrid(const char* gridName, int size)
+{
+  Grid grid(size, size);
+  maze::Backtracker<Grid> backtracker(grid);
+
+  auto start = std::chrono::steady_clock::now();
+  backtracker.Reset(1);
+  backtracker.Run();
+  std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+  std::int64_t cells = grid.CellCount();
+  double gridBytes = double(grid.MemoryUsage()) / cells;
+  double stackBytes = double(backtracker.MemoryUsage()) / cells;
+
+  std::printf("%-6s | %5d x%5d | %12lld | %11.1f | %11.2f | %10.3f | %11.3f\n", gridName, size, size, (long long)cells, elapsed.count(), elapsed.count() * 1e6 / cells, gridBytes, stackBytes);
+}
+
+// Generates the same 10M cell maze a few times and prints the best throughput
+static void BenchmarkBacktracker()
+{
+  const int size = 3163;
+  const int runs = 5;
+
+  maze::PackedGrid grid(size, size);
+  maze::Backtracker<maze::PackedGrid> backtracker(grid);
+
+  double best = 0.0;
+
+  for (int run = 0; run < runs; run++)
+  {
+    auto start = std::chrono::steady_clock::now();
+    backtracker.Reset(1);
+    backtracker.Run();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    double cellsPerSecond = grid.CellCount() / elapsed.count();
+
+    std::printf("run %d: %.2f M cells per second\n", run + 1, cellsPerSecond / 1e6);
+
+    if (cellsPerSecond > best)
+    {
+      best = cellsPerSecond;
+    }
+  }
+
+  std::printf("best of %d on %dx%d cells: %.2f M cells per second\n", runs, size, size, best / 1e6);
+}
+
+// Generates one maze on a ChunkedGrid that hands its finished pages to a sink and prints the peak memory against a flat grid
+template<typename Generator>
+static void BenchmarkChunkedGenerator(const char* generatorName, int size)
+{
+  maze::ChunkedGrid grid(size, size);
+  Generator generator(grid);
+
+  // Stands in for writing the pages somewhere, it only looks at every word so that the work is not skipped
+  std::int64_t releasedPages = 0;
+  std::int64_t openCells = 0;
+
+  grid.SetPageSink([&](const maze::ChunkedGrid& grid, int pageX, int pageY)
+  {
+    releasedPages++;
+
+    for (int y = pageY * maze::ChunkedGrid::PageSize; y < std::min(grid.Height(), (pageY + 1) * maze::ChunkedGrid::PageSize); y++)
+    {
+      openCells += grid.IsOpenRight(grid.Index(pageX * maze::ChunkedGrid::PageSize, y));
+    }
+  });
+
+  auto start = std::chrono::steady_clock::now();
+  generator.Reset(1);
+  generator.Run();
+  grid.Flush();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  std::int64_t cells = grid.CellCount();
+
+  std::printf("%-11s | %5d x%5d | %11.1f | %18.2f | %9.4f | %13.3f | %9lld / %lld\n", generatorName, size, size, elapsed.count() * 1e3, cells / elapsed.count() / 1e6, double(grid.PeakMemoryUsage()) / cells, double(generator.MemoryUsage()) / cells, (long long)releasedPages, (long long)(grid.PagesX()) * grid.PagesY());
+  std::fflush(stdout);
+}
+
+// Compares the peak memory of the chunked grid with a flat PackedGrid (0.375 bytes per cell)
+static void BenchmarkChunked(const std::vector<int>& sizes)
+{
+  std::printf("generator   |         size |   time (ms) | M cells per second | peak grid | generator bytes (per cell) | released pages\n");
+
+  for (int size : sizes)
+  {
+    BenchmarkChunkedGenerator<maze::Eller<maze::ChunkedGrid>>("eller", size);
+    BenchmarkChunkedGenerator<maze::Backtracker<maze::ChunkedGrid>>("backtracker", size);
+  }
+}
+
+// Generates the same maze with and without a stack on a CellGrid and prints throughput and memory besides the grid
+static void BenchmarkStackless(const std::vector<int>& sizes)
+{
+  std::printf("backtracking |         size |   time (ms) | M cells per second | grid bytes | stack bytes (per cell)\n");
+
+  for (int size : sizes)
+  {
+    maze::CellGrid grid(size, size);
+
+    for (bool isStackless : {false, true})
+    {
+      maze::Backtracker<maze::CellGrid> backtracker(grid, isStackless);
+
+      auto start = std::chrono::steady_clock::now();
+      backtracker.Reset(1);
+      backtracker.Run();
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+      std::int64_t cells = grid.CellCount();
+
+      std::printf("%-12s | %5d x%5d | %11.1f | %18.2f | %10.3f | %10.3f\n", isStackless ? "parents" : "stack", size, size, elapsed.count() * 1e3, cells / elapsed.count() / 1e6, double(grid.MemoryUsage()) / cells, double(backtracker.MemoryUsage()) / cells);
+      std::fflush(stdout);
+    }
+  }
+}
+
+// Generated by the compiler, the binary only contains the finished cells
+static constexpr maze::FixedGrid<32, 32> bakedMaze = maze::GenerateFixed<32, 32>(1);
+
+// Compares generating 50x50 mazes with the size known at compile time against the runtime sized backtracker
+static void BenchmarkFixed()
+{
+  const int count = 20000;
+
+  maze::PackedGrid grid(50, 50);
+  maze::Backtracker<maze::PackedGrid> backtracker(grid);
+
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < count; i++)
+  {
+    backtracker.Reset(i);
+    backtracker.Run();
+  }
+
+  std::chrono::duration<double> runtimeSized = std::chrono::steady_clock::now() - start;
+
+  // Summing up a few bits keeps the compiler from dropping the mazes
+  std::int64_t openCells = 0;
+  start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < count; i++)
+  {
+    maze::FixedGrid<50, 50> fixed = maze::GenerateFixed<50, 50>(i);
+    openCells += fixed.IsOpenRight(i % 2500);
+  }
+
+  std::chrono::duration<double> compileTimeSized = std::chrono::steady_clock::now() - start;
+
+  std::printf("%d mazes of 50x50 cells (%lld open checksum)\n", count, (long long)openCells);
+  std::printf("runtime size:      %8.2f us per maze\n", runtimeSized.count() * 1e6 / count);
+  std::printf("compile time size: %8.2f us per maze\n", compileTimeSized.count() * 1e6 / count);
+
+  // The maze baked in at compile time has to be the one the backtracker generates at runtime
+  maze::PackedGrid bakedGrid(32, 32);
+  maze::Backtracker<maze::PackedGrid> bakedBacktracker(bakedGrid);
+  bakedBacktracker.Reset(1);
+  bakedBacktracker.Run();
+
+  std::ostringstream baked;
+  std::ostringstream generated;
+  maze::WriteText(bakedMaze, baked);
+  maze::WriteText(bakedGrid, generated);
+
+  std::printf("32x32 maze baked in at compile time matches the runtime one: %s\n", baked.str() == generated.str() ? "yes" : "no");
+}
+
+// Times one maze with the backtracker on the given grid layout and prints a row of the layout benchmark
+template<typename Grid>
+static void BenchmarkLayout(const char* layoutName, int size, CacheMissCounter& counter)
+{
+  Grid grid(size, size);
+  maze::Backtracker<Grid> backtracker(grid);
+
+  counter.Start();
+  auto start = std::chrono::steady_clock::now();
+  backtracker.Reset(1);
+  backtracker.Run();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  std::int64_t misses = counter.Stop();
+
+  std::int64_t cells = grid.CellCount();
+  char missesPerCell[16] = "n/a";
+
+  if (misses >= 0)
+  {
+    std::snprintf(missesPerCell, sizeof(missesPerCell), "%.3f", double(misses) / cells);
+  }
+
+  std::printf("%-10s | %5d x%5d | %11.1f | %18.2f | %15s | %10.3f\n", layoutName, size, size, elapsed.count() * 1e3, cells / elapsed.count() / 1e6, missesPerCell, double(grid.MemoryUsage()) / cells);
+  std::fflush(stdout);
+}
+
+// Compares the row-major and the Morton ordered grid on mazes that do not fit into the cache
+static void BenchmarkLayouts(const std::vector<int>& sizes)
+{
+  CacheMissCounter counter;
+
+  std::printf("layout     |         size |   time (ms) | M cells per second | misses per cell | grid bytes (per cell)\n");
+
+  for (int size : sizes)
+  {
+    BenchmarkLayout<maze::PackedGrid>("row-major", size, counter);
+    BenchmarkLayout<maze::MortonGrid>("morton", size, counter);
+  }
+
+  if (not counter.IsAvailable())
+  {
+    std::printf("Cache misses are not available, they need Linux and access to the hardware counters (perf_event_paranoid)\n");
+  }
+}
+
+// Generates one maze per algorithm and size and prints throughput and memory
+static void BenchmarkAlgorithms(const std::vector<int>& sizes)
+{
+  std::printf("algorithm    |         size |   time (ms) | M cells per second | grid bytes | algorithm bytes (per cell)\n");
+
+  for (int size : sizes)
+  {
+    maze::PackedGrid grid(size, size);
+
+    for (const std::string& name : maze::GeneratorNames())
+    {
+      std::unique_ptr<maze::Generator<maze::PackedGrid>> generator = maze::MakeGenerator(name, grid);
+
+      auto start = std::chrono::steady_clock::now();
+      generator->Reset(1);
+      generator->Run();
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+      std::int64_t cells = grid.CellCount();
+
+      std::printf("%-12s | %5d x%5d | %11.1f | %18.2f | %10.3f | %10.3f\n", name.c_str(), size, size, elapsed.count() * 1e3, cells / elapsed.count() / 1e6, double(grid.MemoryUsage()) / cells, double(generator->MemoryUsage()) / cells);
+      std::fflush(stdout);
+    }
+  }
+}
+
+// Returns the given fraction of the sorted values, e.g. 0.5 for the median
+static double Percentile(const std::vector<double>& sorted, double fraction)
+{
+  if (sorted.empty())
+  {
+    return 0.0;
+  }
+
+  return sorted[std::min(sorted.size() - 1, std::size_t(fraction * sorted.size()))];
+}
+
+// Generates the same batch with a growing number of threads and prints throughput and latency
+static void BenchmarkBatch(const std::vector<int>& sizes, const Options& options)
+{
+  const std::int64_t count = 10000;
+  int maximumThreads = options.threadCount > 0 ? options.threadCount : int(std::max(1u, std::thread::hardware_concurrency()));
+
+  std::printf("threads |       size |  mazes | mazes per second | p50 (us) | p90 (us) | p99 (us) | max (us) | steals\n");
+
+  for (int size : sizes)
+  {
+    // 1, 2, 4, ... and the maximum at last
+    for (int threads = 1; ; threads = std::min(threads * 2, maximumThreads))
+    {
+      maze::BatchStatistics statistics = maze::GenerateBatch(size, size, options.algorithm, 1, count, threads, nullptr);
+
+      std::vector<double> latencies = statistics.jobSeconds;
+      std::sort(latencies.begin(), latencies.end());
+
+      std::int64_t steals = 0;
+
+      for (std::int64_t workerSteals : statistics.stealsPerWorker)
+      {
+        steals += workerSteals;
+      }
+
+      std::printf("%7d | %4d x%4d | %6lld | %16.1f | %8.1f | %8.1f | %8.1f | %8.1f | %6lld\n", threads, size, size, (long long)count, count / statistics.seconds, Percentile(latencies, 0.5) * 1e6, Percentile(latencies, 0.9) * 1e6, Percentile(latencies, 0.99) * 1e6, latencies.back() * 1e6, (long long)steals);
+      std::fflush(stdout);
+
+      if (threads == maximumThreads)
+      {
+        break;
+      }
+    }
+  }
+}
+
+// Generates the same maze with a growing number of threads and prints the speedup over a single thread
+static void BenchmarkTiled(const std::vector<int>& sizes, const Options& options)
+{
+  int maximumThreads = options.threadCount > 0 ? options.threadCount : int(std::max(1u, std::thread::hardware_concurrency()));
+
+  std::printf("threads |         size |   time (ms) | stitching (ms) | M cells per second | speedup | M cells per second per thread (min - max)\n");
+
+  for (int size : sizes)
+  {
+    maze::PackedGrid grid(size, size);
+    double singleThreadSeconds = 0.0;
+
+    // 1, 2, 4, ... and the maximum at last
+    for (int threads = 1; ; threads = std::min(threads * 2, maximumThreads))
+    {
+      maze::TiledStatistics statistics = maze::GenerateTiled(grid, options.algorithm, 1, threads, options.tileSize);
+      double seconds = statistics.generationSeconds + statistics.stitchingSeconds;
+
+      if (threads == 1)
+      {
+        singleThreadSeconds = seconds;
+      }
+
+      double slowest = 1e300;
+      double fastest = 0.0;
+
+      for (const maze::TileWorkerStatistics& worker : statistics.workers)
+      {
+        double cellsPerSecond = worker.seconds > 0.0 ? worker.cells / worker.seconds : 0.0;
+
+        slowest = std::min(slowest, cellsPerSecond);
+        fastest = std::max(fastest, cellsPerSecond);
+      }
+
+      std::printf("%7d | %5d x%5d | %11.1f | %14.2f | %18.2f | %7.2f | %.2f - %.2f\n", threads, size, size, seconds * 1e3, statistics.stitchingSeconds * 1e3, grid.CellCount() / seconds / 1e6, singleThreadSeconds / seconds, slowest / 1e6, fastest / 1e6);
+      std::fflush(stdout);
+
+      if (threads == maximumThreads)
+      {
+        break;
+      }
+    }
+  }
+}
+
+// Generates chunks of the infinite maze far apart from each other, then pans a view of 100x75 cells (the viewer's window) to the right and down
+static void BenchmarkInfinite(const std::vector<int>& sizes, const Options& options)
+{
+  const int chunkCount = 2000;
+  const int viewWidth = 100;
+  const int viewHeight = 75;
+  const int frameCount = 20000;
+
+  std::printf("chunk size | chunks per second | M cells per second | frames per second | cache misses | cache hits\n");
+
+  for (int size : sizes)
+  {
+    maze::InfiniteMaze infinite(options.seed, size, options.algorithm);
+    maze::Random random(options.seed);
+
+    // Summing up a few bits keeps the compiler from dropping the chunks
+    std::int64_t openCells = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < chunkCount; i++)
+    {
+      maze::PackedGrid chunk = infinite.GenerateChunk(std::int64_t(random()) >> 20, std::int64_t(random()) >> 20);
+      openCells += chunk.IsOpenRight(i % chunk.CellCount());
+    }
+
+    std::chrono::duration<double> generating = std::chrono::steady_clock::now() - start;
+
+    // Every frame moves the view by a cell, looking at every chunk it overlaps like the viewer does
+    start = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frameCount; frame++)
+    {
+      const std::int64_t left = frame;
+      const std::int64_t top = frame / 2;
+
+      for (std::int64_t chunkY = infinite.ChunkOf(top); chunkY <= infinite.ChunkOf(top + viewHeight - 1); chunkY++)
+      {
+        for (std::int64_t chunkX = infinite.ChunkOf(left); chunkX <= infinite.ChunkOf(left + viewWidth - 1); chunkX++)
+        {
+          openCells += infinite.Chunk(chunkX, chunkY).IsOpenDown(frame % (size * size));
+        }
+      }
+    }
+
+    std::chrono::duration<double> panning = std::chrono::steady_clock::now() - start;
+
+    std::printf("%10d | %17.0f | %18.2f | %17.0f | %12lld | %10lld (%lld open checksum)\n", size, chunkCount / generating.count(), chunkCount * double(size) * size / generating.count() / 1e6, frameCount / panning.count(), (long long)infinite.CacheMisses(), (long long)infinite.CacheHits(), (long long)openCells);
+  }
+}
+
+// Runs a solver and prints one row of a table: time, expanded cells per second, path length and memory
+static void PrintSolve(const std::string& solver, const maze::PackedGrid& grid, maze::Point start, maze::Point goal, int threadCount)
+{
+  auto begin = std::chrono::steady_clock::now();
+  maze::Solution solution = maze::Solve(solver, grid, start, goal, threadCount);
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+  std::printf("%-16s | %11.1f | %18.2f | %14lld | %11lld | %10.3f\n", solver.c_str(), elapsed.count() * 1e3, solution.expandedCells / elapsed.count() / 1e6, (long long)solution.expandedCells, (long long)solution.Length(), double(solution.memoryUsage) / grid.CellCount());
+  std::fflush(stdout);
+}
+
+static const char* solveHeader = "solver           |   time (ms) | M cells per second | expanded cells | path length | solver bytes per cell\n";
+
+// Solves one maze per size from the top left to the bottom right corner with every solver
+static void BenchmarkSolvers(const std::vector<int>& sizes, const Options& options)
+{
+  for (int size : sizes)
+  {
+    maze::PackedGrid grid(size, size);
+    std::unique_ptr<maze::Generator<maze::PackedGrid>> generator = maze::MakeGenerator(options.algorithm, grid);
+    generator->Reset(options.seed);
+    generator->Run();
+
+    std::printf("%d x %d cells, %s\n", size, size, options.algorithm.c_str());
+    std::printf("%s", solveHeader);
+
+    for (const std::string& solver : maze::SolverNames())
+    {
+      PrintSolve(solver, grid, {0, 0}, {size - 1, size - 1}, options.threadCount);
+    }
+  }
+}
+
+// Builds a distance index for one maze per size and asks it for the distance and the path between random cells
+static void BenchmarkDistances(const std::vector<int>& sizes, const Options& options)
+{
+  const int queryCount = 10000000;
+  const int pathCount = 100;
+
+  std::printf("        size |  build (ms) | index bytes per cell | M distances per second | M path cells per second | mean path length\n");
+
+  for (int size : sizes)
+  {
+    maze::PackedGrid grid(size, size);
+    std::unique_ptr<maze::Generator<maze::PackedGrid>> generator = maze::MakeGenerator(options.algorithm, grid);
+    generator->Reset(options.seed);
+    generator->Run();
+
+    auto start = std::chrono::steady_clock::now();
+    maze::DistanceIndex index(grid);
+    std::chrono::duration<double> building = std::chrono::steady_clock::now() - start;
+
+    // Summing up the distances keeps the compiler from dropping the queries
+    maze::Random random(options.seed);
+    const std::uint32_t cellCount = std::uint32_t(grid.CellCount());
+    std::int64_t distanceSum = 0;
+
+    start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < queryCount; i++)
+    {
+      distanceSum += index.Distance(std::int64_t(random.Uniform(cellCount)), std::int64_t(random.Uniform(cellCount)));
+    }
+
+    std::chrono::duration<double> querying = std::chrono::steady_clock::now() - start;
+
+    std::int64_t pathCells = 0;
+    start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < pathCount; i++)
+    {
+      pathCells += std::int64_t(index.Path(std::int64_t(random.Uniform(cellCount)), std::int64_t(random.Uniform(cellCount))).size());
+    }
+
+    std::chrono::duration<double> walking = std::chrono::steady_clock::now() - start;
+
+    std::printf("%5d x%5d | %11.1f | %20.2f | %22.2f | %23.2f | %16.1f (%lld distance checksum)\n", size, size, building.count() * 1e3, double(index.MemoryUsage()) / cellCount, queryCount / querying.count() / 1e6, pathCells / walking.count() / 1e6, double(pathCells) / pathCount - 1, (long long)distanceSum);
+    std::fflush(stdout);
+  }
+}
+
+// Computes the distance field from the top left cell with a growing number of threads and prints throughput and how the cells were spread
+static void BenchmarkDistanceField(const std::vector<int>& sizes, const Options& options)
+{
+  int maximumThreads = options.threadCount > 0 ? options.threadCount : int(std::max(1u, std::thread::hardware_concurrency()));
+
+  std::printf("threads |         size |   time (ms) | M cells per second | speedup |   steals | cells per thread (min - max) | furthest cell\n");
+
+  for (int size : sizes)
+  {
+    maze::PackedGrid grid(size, size);
+    std::unique_ptr<maze::Generator<maze::PackedGrid>> generator = maze::MakeGenerator(options.algorithm, grid);
+    generator->Reset(options.seed);
+    generator->Run();
+
+    std::vector<std::uint32_t> distances;
+    double singleThreadSeconds = 0.0;
+
+    // 1, 2, 4, ... and the maximum at last
+    for (int threads = 1; ; threads = std::min(threads * 2, maximumThreads))
+    {
+      maze::DistanceFieldStatistics statistics = maze::ComputeDistanceField(grid, {0, 0}, distances, threads);
+
+      if (threads == 1)
+      {
+        singleThreadSeconds = statistics.seconds;
+      }
+
+      std::int64_t steals = 0;
+
+      for (std::int64_t workerSteals : statistics.stealsPerWorker)
+      {
+        steals += workerSteals;
+      }
+
+      auto [fewest, most] = std::minmax_element(statistics.cellsPerWorker.begin(), statistics.cellsPerWorker.end());
+
+      std::printf("%7d | %5d x%5d | %11.1f | %18.2f | %7.2f | %8lld | %13lld - %12lld | %13u\n", threads, size, size, statistics.seconds * 1e3, grid.CellCount() / statistics.seconds / 1e6, singleThreadSeconds / statistics.seconds, (long long)steals, (long long)*fewest, (long long)*most, statistics.maximumDistance);
+      std::fflush(stdout);
+
+      if (threads == maximumThreads)
+      {
+        break;
+      }
+    }
+  }
+}
+
+int RunBenchmark(const std::string& name, const Options& options)
+{
+  // Uses the sizes from the command line if there are any
+  auto sizesOr = [&options](std::vector<int> sizes)
+  {
+    return options.benchmarkSizes.empty() ? sizes : options.benchmarkSizes;
+  };
+
+  if (name == "grids")
+  {
+    std::printf("grid   |         size |        cells |   time (ms) | ns per cell | grid bytes | stack bytes (per cell)\n");
+
+    for (int size : sizesOr({256, 512, 1024, 2048, 4096, 8192}))
+    {
+      BenchmarkGrid<maze::CellGrid>("cells", size);
+      BenchmarkGrid<maze::PackedGrid>("packed", size);
+    }
+  }
+  else if (name == "backtracker")
+  {
+    BenchmarkBacktracker();
+  }
+  else if (name == "chunked")
+  {
+    BenchmarkChunked(sizesOr({4096, 16384}));
+  }
+  else if (name == "layouts")
+  {
+    BenchmarkLayouts(sizesOr({8192, 32768}));
+  }
+  else if (name == "fixed")
+  {
+    BenchmarkFixed();
+  }
+  else if (name == "stackless")
+  {
+    BenchmarkStackless(sizesOr({1024, 4096}));
+  }
+  else if (name == "algorithms")
+  {
+    BenchmarkAlgorithms(sizesOr({1024, 4096, 16384}));
+  }
+  else if (name == "batch")
+  {
+    BenchmarkBatch(sizesOr({50}), options);
+  }
+  else if (name == "tiled")
+  {
+    BenchmarkTiled(sizesOr({4096}), options);
+  }
+  else if (name == "infinite")
+  {
+    BenchmarkInfinite(sizesOr({16, 64, 256}), options);
+  }
+  else if (name == "solvers")
+  {
+    BenchmarkSolvers(sizesOr({1024, 4096, 16384}), options);
+  }
+  else if (name == "distances")
+  {
+    BenchmarkDistances(sizesOr({256, 1024, 4096}), options);
+  }
+  else if (name == "field")
+  {
+    BenchmarkDistanceField(sizesOr({4096}), options);
+  }
+  else
+  {
+    std::fprintf(stderr, "There is no benchmark called %s\n", name.c_str());
+
+    return 1;
+  }
+
+  return 0;
+}
+
+int RunHeadless(const Options& options)
+{
+  std::error_code error;
+  std::filesystem::create_directories(options.outputDirectory, error);
+
+  if (error)
+  {
+    std::cerr << "Could not create " << options.outputDirectory << ": " << error.message() << "\n";
+
+    return 1;
+  }
+
+  // Runs on many threads at once, so the first failure is only remembered and reported at the end
+  std::atomic<bool> hasFailed = false;
+
+  auto writeMaze = [&](std::int64_t job, const maze::PackedGrid& grid)
+  {
+    char fileName[32];
+    std::snprintf(fileName, sizeof(fileName), "maze_%06lld.%s", (long long)job, options.outputFormat == "binary" ? "maze" : options.outputFormat == "png" ? "png" : "txt");
+
+    std::ofstream file(options.outputDirectory / fileName, std::ios::binary);
+
+    if (options.outputFormat == "binary")
+    {
+      maze::WriteBinary(grid, options.seed + job, options.algorithm, file);
+    }
+    else if (options.outputFormat == "png")
+    {
+      maze::WritePng(grid, file, options.pathWidth);
+    }
+    else
+    {
+      maze::WriteText(grid, file);
+    }
+
+    if (not file and not hasFailed.exchange(true))
+    {
+      std::cerr << "Could not write " << options.outputDirectory / fileName << "\n";
+    }
+  };
+
+  maze::BatchStatistics statistics = maze::GenerateBatch(options.mazeWidth, options.mazeHeight, options.algorithm, options.seed, options.mazeCount, options.threadCount, writeMaze);
+
+  if (hasFailed)
+  {
+    return 1;
+  }
+
+  std::vector<double> latencies = statistics.jobSeconds;
+  std::sort(latencies.begin(), latencies.end());
+
+  std::printf("Wrote %d mazes of %dx%d cells with %s to %s on %zu threads in %.3fs (%.1f mazes per second)\n", options.mazeCount, options.mazeWidth, options.mazeHeight, options.algorithm.c_str(), options.outputDirectory.string().c_str(), statistics.jobsPerWorker.size(), statistics.seconds, options.mazeCount / statistics.seconds);
+  std::printf("Latency per maze: p50 %.1fus, p90 %.1fus, p99 %.1fus, max %.1fus\n", Percentile(latencies, 0.5) * 1e6, Percentile(latencies, 0.9) * 1e6, Percentile(latencies, 0.99) * 1e6, latencies.empty() ? 0.0 : latencies.back() * 1e6);
+  std::printf("Seeds %llu to %llu\n", (unsigned long long)options.seed, (unsigned long long)(options.seed + options.mazeCount - 1));
+
+  return 0;
+}
+
+int RunStream(const Options& options)
+{
+  if (options.mazeWidth < 1)
+  {
+    std::cerr << "The streamed maze needs to be at least 1 cell wide\n";
+
+    return 1;
+  }
+
+  // A height of 0 streams rows without end
+  if (options.mazeHeight < 0)
+  {
+    std::cerr << "The streamed maze can not have a negative height, 0 streams it without end\n";
+
+    return 1;
+  }
+
+  const bool isImage = options.outputFormat == "png";
+
+  // A PNG has to know its height before the first row
+  if (isImage and options.mazeHeight == 0)
+  {
+    std::cerr << "A streamed png needs a height\n";
+
+    return 1;
+  }
+
+  std::ofstream file;
+
+  if (options.streamOutput != "-")
+  {
+    file.open(options.streamOutput, std::ios::binary);
+
+    if (not file)
+    {
+      std::cerr << "Could not open " << options.streamOutput << "\n";
+
+      return 1;
+    }
+  }
+
+  std::ostream& output = file.is_open() ? file : std::cout;
+  std::ios::sync_with_stdio(false);
+
+  maze::EllerStream stream(options.mazeWidth, options.seed);
+  const bool isEndless = options.mazeHeight == 0;
+
+  auto start = std::chrono::steady_clock::now();
+
+  if (isImage)
+  {
+    maze::MazeImage image(output, options.mazeWidth, options.mazeHeight, options.pathWidth);
+
+    while (stream.RowCount() < options.mazeHeight and output)
+    {
+      image.AddRow(stream.NextRow(stream.RowCount() == options.mazeHeight - 1));
+    }
+  }
+  else
+  {
+    maze::WriteTextTop(options.mazeWidth, output);
+
+    while ((isEndless or stream.RowCount() < options.mazeHeight) and output)
+    {
+      maze::WriteTextRow(stream.NextRow(not isEndless and stream.RowCount() == options.mazeHeight - 1), output);
+    }
+  }
+
+  output.flush();
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  // The maze goes to stdout, so the statistics go to stderr
+  std::fprintf(stderr, "Streamed %lld rows of %d cells with seed %llu in %.3fs (%.2f M cells per second, %zu bytes of memory)\n", (long long)stream.RowCount(), options.mazeWidth, (unsigned long long)options.seed, elapsed.count(), stream.RowCount() * double(options.mazeWidth) / elapsed.count() / 1e6, stream.MemoryUsage());
+
+  if (not output)
+  {
+    std::cerr << "Could not write " << options.streamOutput << "\n";
+
+    return 1;
+  }
+
+  return 0;
+}
+
+// Reads the maze from readFile if there is one and generates it otherwise
+// A file written by the mapped mode is mapped instead of being read
+static maze::PackedGrid LoadOrGenerate(const Options& options)
+{
+  if (not options.readFile.empty() and maze::PackedGrid::IsMappedFile(options.readFile))
+  {
+    return maze::PackedGrid::OpenMapped(options.readFile, maze::MappedFile::READ_ONLY);
+  }
+
+  if (not options.readFile.empty())
+  {
+    return maze::MazeFile(options.readFile).Load();
+  }
+
+  maze::PackedGrid grid(options.mazeWidth, options.mazeHeight);
+  std::unique_ptr<maze::Generator<maze::PackedGrid>> generator = maze::MakeGenerator(options.algorithm, grid);
+  generator->Reset(options.seed);
+  generator->Run();
+
+  return grid;
+}
+
+int RunSolve(const Options& options)
+{
+  try
+  {
+    // The cells are checked against the size from the options or the file header before any maze is generated or loaded
+    int width = options.mazeWidth;
+    int height = options.mazeHeight;
+
+    if (not options.readFile.empty() and maze::PackedGrid::IsMappedFile(options.readFile))
+    {
+      const maze::PackedGrid grid = maze::PackedGrid::OpenMapped(options.readFile, maze::MappedFile::READ_ONLY);
+      width = grid.Width();
+      height = grid.Height();
+    }
+    else if (not options.readFile.empty())
+    {
+      maze::MazeFile file(options.readFile);
+      width = file.Width();
+      height = file.Height();
+    }
+
+    const maze::Point from = {options.fromX, options.fromY};
+    const maze::Point to = {options.toX < 0 ? width - 1 : options.toX, options.toY < 0 ? height - 1 : options.toY};
+
+    for (maze::Point cell : {from, to})
+    {
+      if (cell.x < 0 or cell.y < 0 or cell.x >= width or cell.y >= height)
+      {
+        std::cerr << "The cell " << cell.x << "," << cell.y << " does not lie inside the " << width << "x" << height << " maze\n";
+
+        return 1;
+      }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    const maze::PackedGrid grid = LoadOrGenerate(options);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::printf("%dx%d cells %s in %.1fms, from %d,%d to %d,%d\n", grid.Width(), grid.Height(), options.readFile.empty() ? "generated" : "read", elapsed.count() * 1e3, from.x, from.y, to.x, to.y);
+    std::printf("%s", solveHeader);
+
+    for (const std::string& solver : maze::SolverNames())
+    {
+      if (options.solver == "all" or options.solver == solver)
+      {
+        PrintSolve(solver, grid, from, to, options.threadCount);
+      }
+    }
+  }
+  catch (const std::exception& error)
+  {
+    std::cerr << error.what() << "\n";
+
+    return 1;
+  }
+
+  return 0;
+}
+
+int RunAnalyze(const Options& options)
+{
+  try
+  {
+    auto start = std::chrono::steady_clock::now();
+    const maze::PackedGrid grid = LoadOrGenerate(options);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const maze::MazeAnalysis analysis = maze::AnalyzeMaze(grid, options.threadCount);
+
+    std::printf("%dx%d cells %s in %.1fms, analyzed in %.1fms (%.2f M cells per second)\n", grid.Width(), grid.Height(), options.readFile.empty() ? "generated" : "read", elapsed.count() * 1e3, analysis.seconds * 1e3, analysis.cells / analysis.seconds / 1e6);
+    std::fflush(stdout);
+    maze::WriteAnalysis(analysis, std::cout);
+  }
+  catch (const std::exception& error)
+  {
+    std::cerr << error.what() << "\n";
+
+    return 1;
+  }
+
+  return 0;
+}
+
+int RunTiled(const Options& options)
+{
+  std::error_code error;
+  std::filesystem::create_directories(options.outputDirectory, error);
+
+  if (error)
+  {
+    std::cerr << "Could not create " << options.outputDirectory << ": " << error.message() << "\n";
+
+    return 1;
+  }
+
+  maze::PackedGrid grid(options.mazeWidth, options.mazeHeight);
+  maze::TiledStatistics statistics = maze::GenerateTiled(grid, options.algorithm, options.seed, options.threadCount, options.tileSize);
+
+  std::printf("thread |  tiles |        cells |   time (ms) | M cells per second\n");
+
+  for (std::size_t thread = 0; thread < statistics.workers.size(); thread++)
+  {
+    const maze::TileWorkerStatistics& worker = statistics.workers[thread];
+
+    std::printf("%6zu | %6lld | %12lld | %11.1f | %18.2f\n", thread, (long long)worker.tiles, (long long)worker.cells, worker.seconds * 1e3, worker.seconds > 0.0 ? worker.cells / worker.seconds / 1e6 : 0.0);
+  }
+
+  double seconds = statistics.generationSeconds + statistics.stitchingSeconds;
+
+  std::printf("Generated %dx%d cells with %s on %zu threads in %.3fs (%.2f M cells per second, stitching took %.2fms), seed %llu\n", options.mazeWidth, options.mazeHeight, options.algorithm.c_str(), statistics.workers.size(), seconds, grid.CellCount() / seconds / 1e6, statistics.stitchingSeconds * 1e3, (unsigned long long)options.seed);
+
+  std::ofstream file(options.outputDirectory / "maze_tiled.txt", std::ios::binary);
+  maze::WriteText(grid, file);
+
+  if (not file)
+  {
+    std::cerr << "Could not write " << options.outputDirectory / "maze_tiled.txt" << "\n";
+
+    return 1;
+  }
+
+  return 0;
+}
+
+int RunMapped(const Options& options)
+{
+  // Every other algorithm keeps at least 4 bytes per cell on the heap, which defeats a maze larger than the memory
+  if (options.algorithm != "eller" and std::int64_t(options.mazeWidth) * options.mazeHeight >= (std::int64_t(1) << 32))
+  {
+    std::cerr << "Mapped mazes of 2^32 cells or more can only be generated with eller\n";
+
+    return 1;
+  }
+
+  try
+  {
+    auto start = std::chrono::steady_clock::now();
+
+    maze::PackedGrid grid = maze::PackedGrid::CreateMapped(options.mappedFile, options.mazeWidth, options.mazeHeight);
+    std::unique_ptr<maze::Generator<maze::PackedGrid>> generator = maze::MakeGenerator(options.algorithm, grid);
+
+    const bool isTopToBottom = options.algorithm == "eller";
+
+    // Every other algorithm jumps around the whole maze
+    grid.Mapping()->Advise(isTopToBottom ? maze::MappedFile::SEQUENTIAL : maze::MappedFile::RANDOM);
+
+    generator->Reset(options.seed);
+
+    if (isTopToBottom)
+    {
+      // Rows above the one before the current row are done, handing them back every so often keeps the memory at a few rows
+      for (std::int64_t steps = 1; generator->Step(); steps++)
+      {
+        if (steps % (1 << 24) == 0 and generator->HasCurrentCell())
+        {
+          grid.EvictRowsBefore(generator->CurrentCell().y - 1);
+        }
+      }
+    }
+    else
+    {
+      generator->Run();
+    }
+
+    std::chrono::duration<double> generated = std::chrono::steady_clock::now() - start;
+
+    grid.Mapping()->Flush(true);
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::printf("Generated %dx%d cells with %s into %s (%.1f MB) in %.3fs, %.3fs of it writing back (%.2f M cells per second), seed %llu\n", options.mazeWidth, options.mazeHeight, options.algorithm.c_str(), options.mappedFile.string().c_str(), grid.Mapping()->Size() / 1e6, elapsed.count(), elapsed.count() - generated.count(), grid.CellCount() / elapsed.count() / 1e6, (unsigned long long)options.seed);
+  }
+  catch (const std::exception& error)
+  {
+    std::cerr << error.what() << "\n";
+
+    return 1;
+  }
+
+  return 0;
+}
+
+int RunRead(const Options& options)
+{
+  try
+  {
+    // A file of the mapped mode is mapped as a whole, only the rows that are written are paged in
+    if (maze::PackedGrid::IsMappedFile(options.readFile))
+    {
+      const maze::PackedGrid grid = maze::PackedGrid::OpenMapped(options.readFile, maze::MappedFile::READ_ONLY);
+
+      int endRow = options.endRow < 0 ? grid.Height() : options.endRow;
+
+      std::fprintf(stderr, "%s: %dx%d cells, mapped grid\n", options.readFile.string().c_str(), grid.Width(), grid.Height());
+
+      maze::WriteText(grid, options.firstRow, endRow, std::cout);
+
+      return 0;
+    }
+
+    maze::MazeFile file(options.readFile);
+
+    int endRow = options.endRow < 0 ? file.Height() : options.endRow;
+
+    std::fprintf(stderr, "%s: %dx%d cells, %s, seed %llu, %s\n", options.readFile.string().c_str(), file.Width(), file.Height(), file.Algorithm().c_str(), (unsigned long long)file.Seed(), file.HasIndex() ? "checked rows" : "no index");
+
+    maze::WriteText(file.Rows(options.firstRow, endRow), std::cout);
+  }
+  catch (const std::exception& error)
+  {
+    std::cerr << error.what() << "\n";
+
+    return 1;
+  }
+
+  return 0;
+}
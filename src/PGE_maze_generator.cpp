@@ -1,71 +1,118 @@
 #define OLC_PGE_APPLICATION
 #include "olcPixelGameEngine.h"
-#include <stack>
-
-enum Direction
+#include "Commands.h"
+#include "maze/Analytics.h"
+#include "maze/Generator.h"
+#include "maze/InfiniteMaze.h"
+#include "maze/PackedGrid.h"
+#include "maze/Random.h"
+#include "maze/Solver.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using maze::Direction;
+using maze::NOT_SET;
+using maze::UP;
+using maze::LEFT;
+using maze::DOWN;
+using maze::RIGHT;
+
+// How far the maze advances every time the delay has passed
+struct Speed
 {
-  NOT_SET,
-  UP,
-  LEFT,
-  DOWN,
-  RIGHT
+  const char* label; // At most 4 characters wide
+  int steps; // Number of steps to take, 0 means as many as fit into timeBudget
+  float timeBudget; // Seconds to spend generating if steps is 0, a negative budget finishes the maze at once
 };
 
-struct cell {
-  bool hasBeenPainted;
-  Direction direction;
+const Speed speeds[] = {
+  {"1", 1, 0.0f},
+  {"10", 10, 0.0f},
+  {"100", 100, 0.0f},
+  {"1k", 1000, 0.0f},
+  {"10ms", 0, 0.01f},
+  {"all", 0, -1.0f}
+};
 
-public:
-  cell()
+const int speedCount = sizeof(speeds) / sizeof(Speed);
+
+// Returns the index of the speed with the given label, or -1 if there is none
+int SpeedIndex(const std::string& label)
+{
+  for (int speed = 0; speed < speedCount; speed++)
   {
-    hasBeenPainted = false;
-    direction = NOT_SET;
+    if (label == speeds[speed].label)
+    {
+      return speed;
+    }
   }
 
-  cell(bool hasBeenPainted, Direction direction)
+  return -1;
+}
+
+// Returns the index of the algorithm in maze::GeneratorNames(), or -1 if there is none
+int AlgorithmIndex(const std::string& name)
+{
+  const std::vector<std::string>& names = maze::GeneratorNames();
+
+  for (std::size_t algorithm = 0; algorithm < names.size(); algorithm++)
   {
-    this->hasBeenPainted = hasBeenPainted;
-    this->direction = direction;
+    if (name == names[algorithm])
+    {
+      return int(algorithm);
+    }
   }
-};
 
+  return -1;
+}
+
+// Animates the maze library's generators, a configurable number of steps per delay tick
 class MazeGenerator : public olc::PixelGameEngine
 {
 public:
-  MazeGenerator()
+  MazeGenerator(const Options& options) :
+    speedIndex(SpeedIndex(options.speed)),
+    algorithmIndex(AlgorithmIndex(options.algorithm)),
+    nextSeed(options.seed),
+    maze(options.mazeWidth, options.mazeHeight),
+    cellCount(maze.CellCount()),
+    isDirty(cellCount)
   {
     sAppName = "Maze generator";
   }
 
+  static const int pathWidth = 3; // Path width in pixels
+  static const int UISectionHeight = 44;
+
 private:
-  const int mazeWidth = 50; // Maze width in maze cells
-  const int mazeHeight = 50; // Maze height in maze cells
-  const int cellCount = 2500; // Number of cells in the maze
-  const int pathWidth = 3; // Path width in pixels
-  cell maze[2500]; // Vector containing all cells and their data/information
-  // TODO: maybe we can do without visitedCellsCounter
-  int visitedCellsCounter; // Number of cells that has been visited
-  std::stack<olc::vi2d> unvisitedCells; // Contains all maze cells (as coordinates) who's direction has not yet been set
+  int speedIndex; // Index into speeds
+  int algorithmIndex; // Index into maze::GeneratorNames(), used for the next maze
+  std::uint64_t nextSeed; // Seed of the next maze, every new maze counts it up by one
+  maze::PackedGrid maze; // Contains all cells and their walls
+  std::unique_ptr<maze::Generator<maze::PackedGrid>> generator; // Generates the maze in maze, created with the first maze
+  const std::int64_t cellCount; // Number of cells in the maze
+  std::vector<std::int64_t> dirtyCells; // Cells that changed since they have last been painted
+  std::vector<bool> isDirty; // Whether a cell is already in dirtyCells
+  bool repaintAllCells = true; // Set when the whole maze needs to be painted, e.g. after a reset
+  std::vector<std::string> analysisLines; // Analysis of the finished maze, drawn over the maze while there are any
   float delay; // Delay in seconds
   float timePassed;
-  const int UISectionHeight = 20;
   olc::vi2d mouse;
 
 public:
   bool OnUserCreate() override
   {
-    // Initializing the random number generator
-    srand(time(nullptr));
-
-    visitedCellsCounter = cellCount + 1;
     delay = 0.01f;
 
-    // Set all the maze cells to have no direction
-    for (cell& cell : maze)
-    {
-      cell.direction = NOT_SET;
-    }
-
     Clear(olc::BLACK);
 
     // Drawing the UI section
@@ -76,6 +123,16 @@ public:
     DrawString(105, 10, "<", olc::MAGENTA);
     DrawString(113, 10, std::to_string(delay).substr(3, 2) + "ms", olc::GREY);
     DrawString(145, 10, ">", olc::MAGENTA);
+    DrawString(1, 18, "steps per tick:", olc::GREY);
+    DrawString(129, 18, "<", olc::MAGENTA);
+    DrawString(137, 18, speeds[speedIndex].label, olc::GREY);
+    DrawString(169, 18, ">", olc::MAGENTA);
+    DrawString(1, 26, "algorithm:", olc::GREY);
+    DrawString(89, 26, "<", olc::MAGENTA);
+    DrawString(97, 26, maze::GeneratorNames()[algorithmIndex], olc::GREY);
+    DrawString(193, 26, ">", olc::MAGENTA);
+    DrawString(1, 34, "analyze maze:", olc::GREY);
+    DrawString(113, 34, "I", olc::MAGENTA);
 
     PaintingRoutine();
 
@@ -118,22 +175,69 @@ public:
       DrawString(113, 10, std::to_string(delay).substr(3, 2) + "ms", olc::GREY);
     }
 
+    // Slowing down (accounting for clicking the character on screen)
+    if (GetKey(olc::Key::DOWN).bPressed or (mouse.x > 128 and mouse.y > 17 and mouse.x < 128 + 6 and mouse.y < 17 + 8 and GetMouse(0).bPressed))
+    {
+      speedIndex = std::max(speedIndex - 1, 0);
+
+      // Re-painting the speed in the UI section
+      FillRect(137, 18, 32, 7, olc::BLACK);
+      DrawString(137, 18, speeds[speedIndex].label, olc::GREY);
+    }
+
+    // Speeding up (accounting for clicking the character on screen)
+    if (GetKey(olc::Key::UP).bPressed or (mouse.x > 168 and mouse.y > 17 and mouse.x < 168 + 6 and mouse.y < 17 + 8 and GetMouse(0).bPressed))
+    {
+      speedIndex = std::min(speedIndex + 1, speedCount - 1);
+
+      // Re-painting the speed in the UI section
+      FillRect(137, 18, 32, 7, olc::BLACK);
+      DrawString(137, 18, speeds[speedIndex].label, olc::GREY);
+    }
+
+    // Choosing the previous or next algorithm for the next maze (accounting for clicking the characters on screen)
+    bool previousAlgorithm = mouse.x > 88 and mouse.y > 25 and mouse.x < 88 + 6 and mouse.y < 25 + 8 and GetMouse(0).bPressed;
+    bool nextAlgorithm = GetKey(olc::Key::TAB).bPressed or (mouse.x > 192 and mouse.y > 25 and mouse.x < 192 + 6 and mouse.y < 25 + 8 and GetMouse(0).bPressed);
+
+    if (previousAlgorithm or nextAlgorithm)
+    {
+      int algorithmCount = int(maze::GeneratorNames().size());
+
+      algorithmIndex = (algorithmIndex + (nextAlgorithm ? 1 : algorithmCount - 1)) % algorithmCount;
+
+      // Re-painting the algorithm in the UI section
+      FillRect(97, 26, 96, 7, olc::BLACK);
+      DrawString(97, 26, maze::GeneratorNames()[algorithmIndex], olc::GREY);
+    }
+
     // Generate new maze when ENTER key is pressed (accounting for clicking the character on screen)
     if (GetKey(olc::Key::ENTER).bPressed or (mouse.x > 128 and mouse.y > 1 and mouse.x < 129 + 39 and mouse.y < 2 + 7 and GetMouse(0).bPressed))
     {
       FillRect(0, UISectionHeight, ScreenWidth(), ScreenHeight(), olc::BLACK);
 
-      visitedCellsCounter = 1;
+      // Printing the algorithm and seed so that the maze can be generated again with --algorithm and --seed
+      std::cout << maze::GeneratorNames()[algorithmIndex] << " seed " << nextSeed << std::endl;
 
-      // Resetting all maze data
-      for (cell& cell : maze)
+      generator = maze::MakeGenerator(maze::GeneratorNames()[algorithmIndex], maze);
+      generator->Reset(nextSeed++);
+
+      analysisLines.clear();
+      repaintAllCells = true;
+    }
+
+    // Showing or hiding the analysis of the finished maze (accounting for clicking the character on screen)
+    if (GetKey(olc::Key::I).bPressed or (mouse.x > 112 and mouse.y > 33 and mouse.x < 112 + 6 and mouse.y < 33 + 8 and GetMouse(0).bPressed))
+    {
+      if (not analysisLines.empty())
       {
-        cell.direction = NOT_SET;
-        cell.hasBeenPainted = false;
+        // The cells below the panel come back with the next painting routine
+        analysisLines.clear();
+        repaintAllCells = true;
+      }
+      else if (generator and generator->IsDone())
+      {
+        AnalyzeFinishedMaze();
       }
-
-      // The top leftmost cell is going to be the starting point for the maze
-      unvisitedCells.push(olc::vi2d{0, 0});
     }
 
     timePassed += fElapsedTime;
@@ -145,123 +249,200 @@ public:
       timePassed = 0;
 
       // As long as there are unvisited cells, update the maze
-      if (visitedCellsCounter < cellCount)
+      if (generator and not generator->IsDone())
       {
-        std::vector<Direction> validNeighbours;
+        GenerationRoutine(speeds[speedIndex]);
+      }
 
-        // Checks if neighbours exist and if their direction has been set
-        addAllValidNeighbours(validNeighbours);
+      PaintingRoutine();
+    }
 
-        // If there are any valid neighbours choose a random one
-        if (not validNeighbours.empty())
-        {
-          // Chooses a random neighbour from all valid neighbours
-          Direction nextCellDirection = validNeighbours[rand() % validNeighbours.size()];
+    return true;
+  }
 
-          cell& currentCell = maze[IndexOfCurrentCell()];
 
-          // Set the current cell's direction to point towards the selected neighbour
-          currentCell.direction = nextCellDirection;
-          currentCell.hasBeenPainted = false;
+  // -----
 
-          // Push the selected cell onto the stack
-          unvisitedCells.push(CoordinatesOfNeighbour(nextCellDirection));
 
-          visitedCellsCounter++;
-        }
-        // There are no valid neighbours so we need to back-track until we find some valid ones
-        else
-        {
-          // Setting the enpoint cell's direction to point to its previous cell on the stack
-          // While backtracking we reverse all the directions that have been set (dunno why but it seems to work)
-          cell& previousCell = maze[IndexOfCurrentCell()];
+private:
+  // Advances the maze as far as the speed allows
+  void GenerationRoutine(const Speed& speed)
+  {
+    // The current cell changes with every step so it needs to be re-painted before and after
+    MarkChangesForPainting();
 
-          unvisitedCells.pop();
+    if (speed.steps > 0)
+    {
+      for (int i = 0; i < speed.steps and generator->Step(); i++)
+      {
+        MarkChangesForPainting();
+      }
 
-          switch (maze[IndexOfCurrentCell()].direction)
-          {
-            case UP:
-              previousCell.direction = DOWN;
-            break;
+      return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
 
-            case LEFT:
-              previousCell.direction = RIGHT;
-            break;
+    while (not generator->IsDone())
+    {
+      // Looking at the clock is a lot slower than a step so it only happens every so often
+      for (int i = 0; i < 1024 and generator->Step(); i++)
+      {
+        MarkChangesForPainting();
+      }
 
-            case DOWN:
-              previousCell.direction = UP;
-            break;
+      if (speed.timeBudget >= 0.0f and std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count() > speed.timeBudget)
+      {
+        break;
+      }
+    }
+  }
 
-            case RIGHT:
-              previousCell.direction = LEFT;
-            break;
-          }
+  // Prints the analysis of the maze in full and keeps a short version of it to be drawn over the maze
+  void AnalyzeFinishedMaze()
+  {
+    const maze::MazeAnalysis analysis = maze::AnalyzeMaze(maze);
 
-          previousCell.hasBeenPainted = false;
-        }
+    std::cout << maze::GeneratorNames()[algorithmIndex] << " seed " << nextSeed - 1 << " analyzed in " << analysis.seconds * 1e3 << "ms\n";
+    maze::WriteAnalysis(analysis, std::cout);
+    std::cout.flush();
 
-        PaintingRoutine();
-      }
+    std::int64_t corridors = 0;
+
+    for (std::int64_t count : analysis.corridorLengths)
+    {
+      corridors += count;
     }
 
-    return true;
+    // The UI section is 201 pixels wide at least, which leaves room for 24 characters a line
+    auto line = [this](const char* format, auto... values)
+    {
+      char text[64];
+      std::snprintf(text, sizeof(text), format, values...);
+      analysisLines.push_back(text);
+    };
+
+    line("dead ends %lld %.1f%%", (long long)analysis.deadEnds, 100.0 * analysis.deadEnds / analysis.cells);
+    line("3-way %lld 4-way %lld", (long long)analysis.threeWayJunctions, (long long)analysis.fourWayJunctions);
+    line("corridors %lld", (long long)corridors);
+    line("longest   %lld", (long long)(analysis.corridorLengths.empty() ? 0 : analysis.corridorLengths.size() - 1));
+    line("straight  %.1f%%", analysis.straightness * 100.0);
+    line("river     %.2f", analysis.riverFactor);
+    line("diameter  %lld", (long long)analysis.diameter);
   }
 
+  // Makes the current cell and the two cells of the last opened passage get re-painted with the next painting routine
+  void MarkChangesForPainting()
+  {
+    if (generator->HasCurrentCell())
+    {
+      maze::Point current = generator->CurrentCell();
 
-  // -----
+      MarkForPainting(maze.Index(current.x, current.y));
+    }
 
+    maze::Carving carving = generator->LastCarving();
 
-private:
-  // Draws the maze to the screen
-  void PaintingRoutine()
+    if (carving.direction != NOT_SET)
+    {
+      MarkForPainting(carving.index);
+      MarkForPainting(maze.Neighbour(carving.index, carving.direction));
+    }
+  }
+
+  // Queues a cell for the next painting routine, every cell is queued at most once
+  void MarkForPainting(std::int64_t cellIndex)
   {
-    // TODO: rework this to use for (cell& cell : maze)
-    // Draws each cell
-    for (int currentCellIndex = 0; currentCellIndex < cellCount; currentCellIndex++)
+    if (not repaintAllCells and not isDirty[cellIndex])
     {
-      // Calculating the x and y coordinates of the current cell
-      // x = index % height
-      // y = index / height
-      olc::vi2d currentCell = {currentCellIndex % mazeHeight, currentCellIndex / mazeHeight};
+      isDirty[cellIndex] = true;
+      dirtyCells.push_back(cellIndex);
+    }
+  }
 
-      // Painting the cell only if it hasn't been painted before
-      if (not maze[currentCellIndex].hasBeenPainted)
+  // Draws every cell that changed since the last painting routine, or the whole maze if it has been reset
+  void PaintingRoutine()
+  {
+    if (repaintAllCells)
+    {
+      for (std::int64_t currentCellIndex : dirtyCells)
       {
-        olc::Pixel interiorColor;
+        isDirty[currentCellIndex] = false;
+      }
 
-        // Paints the cell interior
-        if (maze[currentCellIndex].direction == NOT_SET)
-        {
-          interiorColor = olc::BLUE;
-        }
-        else
-        {
-          interiorColor = olc::WHITE;
-        }
+      for (std::int64_t currentCellIndex = 0; currentCellIndex < cellCount; currentCellIndex++)
+      {
+        paintCell(currentCellIndex);
+      }
 
-        paintCellInterior(currentCell, interiorColor);
-        paintCellWall(currentCell, maze[currentCellIndex].direction);
+      repaintAllCells = false;
+    }
+    else
+    {
+      for (std::int64_t currentCellIndex : dirtyCells)
+      {
+        paintCell(currentCellIndex);
 
-        maze[currentCellIndex].hasBeenPainted = true;
+        isDirty[currentCellIndex] = false;
       }
+    }
+
+    dirtyCells.clear();
+
+    // The analysis stays on top of the cells until it is hidden again
+    if (not analysisLines.empty())
+    {
+      int panelHeight = int(analysisLines.size()) * 8 + 3;
 
-      // If this cell is the top of the stack
-      // HACK: the -1 correction on the x is necessary for some reason
-      currentCell.x--;
+      FillRect(2, UISectionHeight + 2, ScreenWidth() - 4, panelHeight, olc::BLACK);
+      DrawRect(2, UISectionHeight + 2, ScreenWidth() - 5, panelHeight - 1, olc::CYAN);
 
-      if (not (unvisitedCells.empty()) and currentCell.x == unvisitedCells.top().x and currentCell.y == unvisitedCells.top().y)
+      for (std::size_t i = 0; i < analysisLines.size(); i++)
       {
-        // On the last painting cycle the top of the stack is painted as a regular cell
-        if (visitedCellsCounter == cellCount)
-        {
-          paintCellInterior(currentCell, olc::WHITE);
+        DrawString(4, UISectionHeight + 4 + int(i) * 8, analysisLines[i], olc::GREY);
+      }
+    }
+  }
 
-          continue;
-        }
+  // Paints the interior of a cell and its open walls
+  void paintCell(std::int64_t currentCellIndex)
+  {
+    maze::Point coordinates = maze.Coordinates(currentCellIndex);
+    olc::vi2d currentCell = {coordinates.x, coordinates.y};
+    bool isVisited = maze.IsVisited(currentCellIndex);
+
+    olc::Pixel interiorColor;
 
-        paintCellInterior(currentCell, olc::GREEN);
+    // Paints the cell interior
+    if (not isVisited)
+    {
+      interiorColor = olc::BLUE;
+    }
+    // The current cell is highlighted until the maze is finished, then it is painted as a regular cell
+    else if (generator and not generator->IsDone() and generator->HasCurrentCell() and maze.Index(generator->CurrentCell().x, generator->CurrentCell().y) == currentCellIndex)
+    {
+      interiorColor = olc::GREEN;
+    }
+    else
+    {
+      interiorColor = olc::WHITE;
+    }
 
-        maze[currentCellIndex].hasBeenPainted = false;
+    paintCellInterior(currentCell, interiorColor);
+
+    // Unvisited cells get their walls blacked out, visited ones paint every wall that has been opened
+    if (not isVisited)
+    {
+      paintCellWall(currentCell, NOT_SET);
+
+      return;
+    }
+
+    for (Direction direction : {UP, LEFT, DOWN, RIGHT})
+    {
+      if (maze.IsPassage(coordinates.x, coordinates.y, direction))
+      {
+        paintCellWall(currentCell, direction);
       }
     }
   }
@@ -316,127 +497,466 @@ private:
       }
     }
   }
+};
+
+// Shows an endless maze that can be moved around with the arrow keys, WASD or by dragging it with the mouse
+// Only the chunks inside the window are generated, the maze keeps the recently seen ones in its cache
+class InfiniteViewer : public olc::PixelGameEngine
+{
+public:
+  InfiniteViewer(const Options& options) :
+    maze(options.seed, options.chunkSize, options.algorithm)
+  {
+    sAppName = "Infinite maze";
+  }
+
+  static const int pathWidth = 3; // Path width in pixels
+  static const int cellWidth = pathWidth + 1; // A cell and the wall to its right or below it
+  static const int UISectionHeight = 10;
+
+private:
+  maze::InfiniteMaze maze;
+  double cameraX = 0.0; // Maze pixel in the top left corner of the view, the top left corner of cell 0, 0 being pixel 0, 0
+  double cameraY = 0.0;
+  std::int64_t paintedX = 0; // Where the camera was when the view was last painted
+  std::int64_t paintedY = 0;
+  bool repaint = true;
+  olc::vi2d mouse;
+
+public:
+  bool OnUserCreate() override
+  {
+    Clear(olc::BLACK);
+
+    return true;
+  }
 
-  // Returns an vector of valid directions to choose from.
-  // Maze cells outside the edge of the maze are not added to the vector
-  void addAllValidNeighbours(std::vector<Direction>& neighbours)
+  bool OnUserUpdate(float fElapsedTime) override
   {
-    // If the upper neighbour exists and is not set, add it as a valid neighbour
-    if (unvisitedCells.top().y > 0 and maze[IndexOfNeighbour(UP)].direction == NOT_SET)
+    olc::vi2d previousMouse = mouse;
+    mouse = {GetMouseX(), GetMouseY()};
+
+    // Pixels per second, SHIFT moves faster
+    double speed = (GetKey(olc::Key::SHIFT).bHeld ? 2000.0 : 300.0) * fElapsedTime;
+
+    if (GetKey(olc::Key::LEFT).bHeld or GetKey(olc::Key::A).bHeld)
+    {
+      cameraX -= speed;
+    }
+
+    if (GetKey(olc::Key::RIGHT).bHeld or GetKey(olc::Key::D).bHeld)
+    {
+      cameraX += speed;
+    }
+
+    if (GetKey(olc::Key::UP).bHeld or GetKey(olc::Key::W).bHeld)
+    {
+      cameraY -= speed;
+    }
+
+    if (GetKey(olc::Key::DOWN).bHeld or GetKey(olc::Key::S).bHeld)
     {
-      neighbours.push_back(UP);
+      cameraY += speed;
     }
 
-    // If the left neighbour exists and is not set, add it as a valid neighbour
-    if (unvisitedCells.top().x > 0 and maze[IndexOfNeighbour(LEFT)].direction == NOT_SET)
+    // Dragging moves the maze along with the mouse
+    if (GetMouse(0).bHeld and not GetMouse(0).bPressed)
     {
-      neighbours.push_back(LEFT);
+      cameraX -= mouse.x - previousMouse.x;
+      cameraY -= mouse.y - previousMouse.y;
     }
 
-    // If the lower neighbour exists and is not set, add it as a valid neighbour
-    if (unvisitedCells.top().y < mazeWidth - 1 and maze[IndexOfNeighbour(DOWN)].direction == NOT_SET)
+    // Back to where the maze started
+    if (GetKey(olc::Key::HOME).bPressed)
     {
-      neighbours.push_back(DOWN);
+      cameraX = 0.0;
+      cameraY = 0.0;
     }
 
-    // If the right neighbour exists and is not set, add it as a valid neighbour
-    if (unvisitedCells.top().x < mazeHeight - 1 and maze[IndexOfNeighbour(RIGHT)].direction == NOT_SET)
+    std::int64_t viewX = std::int64_t(std::floor(cameraX));
+    std::int64_t viewY = std::int64_t(std::floor(cameraY));
+
+    if (repaint or viewX != paintedX or viewY != paintedY)
     {
-      neighbours.push_back(RIGHT);
+      PaintingRoutine(viewX, viewY);
+
+      paintedX = viewX;
+      paintedY = viewY;
+      repaint = false;
     }
+
+    return true;
   }
 
-  // Returns the index of a cell's neighbour in maze
-  int IndexOfNeighbour(olc::vi2d direction)
+
+  // -----
+
+
+private:
+  // Rounds towards negative infinity, the view can be anywhere in the plane
+  static std::int64_t FloorDivide(std::int64_t value, std::int64_t divisor)
   {
-    return (unvisitedCells.top().y + direction.y) * mazeWidth + (unvisitedCells.top().x + direction.x);
+    return (value >= 0 ? value : value - divisor + 1) / divisor;
   }
 
-  // Returns the index of a cell's neighbour in maze or the current cell's
-  int IndexOfNeighbour(Direction direction)
+  // Paints every cell that is at least partly inside the view, chunk by chunk
+  void PaintingRoutine(std::int64_t viewX, std::int64_t viewY)
   {
-    int index;
+    FillRect(0, UISectionHeight, ScreenWidth(), ScreenHeight() - UISectionHeight, olc::BLACK);
+
+    const int chunkSize = maze.ChunkSize();
+    // A cell paints the pixels from one after its top left corner up to its walls on the right and below, so the first column and row of pixels belong to the cells before the view
+    const std::int64_t firstX = FloorDivide(viewX - 1, cellWidth);
+    const std::int64_t firstY = FloorDivide(viewY - 1, cellWidth);
+    const std::int64_t lastX = FloorDivide(viewX + ScreenWidth(), cellWidth);
+    const std::int64_t lastY = FloorDivide(viewY + ScreenHeight() - UISectionHeight, cellWidth);
 
-    switch (direction)
+    for (std::int64_t chunkY = maze.ChunkOf(firstY); chunkY <= maze.ChunkOf(lastY); chunkY++)
     {
-      case NOT_SET:
-        index = (unvisitedCells.top().y) * mazeWidth + (unvisitedCells.top().x);
-      break;
+      for (std::int64_t chunkX = maze.ChunkOf(firstX); chunkX <= maze.ChunkOf(lastX); chunkX++)
+      {
+        // Passages out of the right and bottom border are the exits of the neighbouring chunks, which need not be generated for it
+        const maze::PackedGrid& chunk = maze.Chunk(chunkX, chunkY);
+        const maze::ChunkExit rightExit = maze.Exit(chunkX + 1, chunkY);
+        const maze::ChunkExit belowExit = maze.Exit(chunkX, chunkY + 1);
 
-      case UP:
-        index = (unvisitedCells.top().y - 1) * mazeWidth + (unvisitedCells.top().x);
-      break;
+        for (std::int64_t y = std::max(firstY, chunkY * chunkSize); y <= std::min(lastY, chunkY * chunkSize + chunkSize - 1); y++)
+        {
+          for (std::int64_t x = std::max(firstX, chunkX * chunkSize); x <= std::min(lastX, chunkX * chunkSize + chunkSize - 1); x++)
+          {
+            int localX = int(x - chunkX * chunkSize);
+            int localY = int(y - chunkY * chunkSize);
+            std::int64_t index = chunk.Index(localX, localY);
 
-      case LEFT:
-        index = (unvisitedCells.top().y) * mazeWidth + (unvisitedCells.top().x - 1);
-      break;
+            bool isOpenRight = localX < chunkSize - 1 ? chunk.IsOpenRight(index) : rightExit.direction == LEFT and rightExit.position == localY;
+            bool isOpenDown = localY < chunkSize - 1 ? chunk.IsOpenDown(index) : belowExit.direction == UP and belowExit.position == localX;
+
+            paintCell(int(x * cellWidth - viewX), int(y * cellWidth - viewY) + UISectionHeight, isOpenRight, isOpenDown);
+          }
+        }
+      }
+    }
 
-      case DOWN:
-        index = (unvisitedCells.top().y + 1) * mazeWidth + (unvisitedCells.top().x);
-      break;
+    // Drawing the UI section last keeps cells from showing through it
+    FillRect(0, 0, ScreenWidth(), UISectionHeight, olc::BLACK);
+    DrawString(1, 1, "cell " + std::to_string(FloorDivide(viewX, cellWidth)) + "," + std::to_string(FloorDivide(viewY, cellWidth)) + " chunks " + std::to_string(maze.CachedChunks()) + " generated " + std::to_string(maze.CacheMisses()), olc::GREY);
+  }
 
-      case RIGHT:
-        index = (unvisitedCells.top().y) * mazeWidth + (unvisitedCells.top().x + 1);
-      break;
+  // Paints the interior of a cell whose top left wall pixel is at x and y, and the walls to its right and below it if they are open
+  void paintCell(int x, int y, bool isOpenRight, bool isOpenDown)
+  {
+    FillRect(x + 1, y + 1, pathWidth, pathWidth, olc::WHITE);
+
+    if (isOpenRight)
+    {
+      FillRect(x + 1 + pathWidth, y + 1, 1, pathWidth, olc::WHITE);
+    }
+
+    if (isOpenDown)
+    {
+      FillRect(x + 1, y + 1 + pathWidth, pathWidth, 1, olc::WHITE);
+    }
+  }
+};
+
+int main(int argc, char* argv[])
+{
+  Options options;
+  options.seed = maze::RandomSeed();
+  bool headless = false;
+  bool stream = false;
+  bool tiled = false;
+  bool infinite = false;
+  bool solve = false;
+  bool analyze = false;
+  bool isAlgorithmGiven = false;
+  const char* benchmark = nullptr;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (std::strcmp(argv[i], "--benchmark") == 0)
+    {
+      // The name of the benchmark is optional
+      benchmark = i + 1 < argc and argv[i + 1][0] != '-' ? argv[++i] : "grids";
+    }
+    else if (std::strcmp(argv[i], "--sizes") == 0 and i + 1 < argc)
+    {
+      // A comma separated list like 1024,4096
+      for (char* size = std::strtok(argv[++i], ","); size != nullptr; size = std::strtok(nullptr, ","))
+      {
+        options.benchmarkSizes.push_back(std::atoi(size));
+      }
+    }
+    else if (std::strcmp(argv[i], "--width") == 0 and i + 1 < argc)
+    {
+      options.mazeWidth = std::atoi(argv[++i]);
+    }
+    else if (std::strcmp(argv[i], "--height") == 0 and i + 1 < argc)
+    {
+      options.mazeHeight = std::atoi(argv[++i]);
+    }
+    else if (std::strcmp(argv[i], "--speed") == 0 and i + 1 < argc)
+    {
+      options.speed = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--seed") == 0 and i + 1 < argc)
+    {
+      options.seed = std::strtoull(argv[++i], nullptr, 10);
+    }
+    else if (std::strcmp(argv[i], "--algorithm") == 0 and i + 1 < argc)
+    {
+      options.algorithm = argv[++i];
+      isAlgorithmGiven = true;
+    }
+    else if (std::strcmp(argv[i], "--headless") == 0)
+    {
+      headless = true;
+    }
+    else if (std::strcmp(argv[i], "--mapped") == 0 and i + 1 < argc)
+    {
+      options.mappedFile = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--format") == 0 and i + 1 < argc)
+    {
+      options.outputFormat = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--path-width") == 0 and i + 1 < argc)
+    {
+      options.pathWidth = std::atoi(argv[++i]);
+    }
+    else if (std::strcmp(argv[i], "--read") == 0 and i + 1 < argc)
+    {
+      options.readFile = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--rows") == 0 and i + 1 < argc)
+    {
+      // Either "first,end" or just "first"
+      char* end = nullptr;
+      options.firstRow = int(std::strtol(argv[++i], &end, 10));
+      options.endRow = *end == ',' ? std::atoi(end + 1) : -1;
+    }
+    else if (std::strcmp(argv[i], "--solve") == 0)
+    {
+      // The name of the solver is optional
+      solve = true;
+
+      if (i + 1 < argc and argv[i + 1][0] != '-')
+      {
+        options.solver = argv[++i];
+      }
+    }
+    else if (std::strcmp(argv[i], "--analyze") == 0)
+    {
+      analyze = true;
+    }
+    else if (std::strcmp(argv[i], "--from") == 0 and i + 1 < argc)
+    {
+      // "x,y"
+      char* end = nullptr;
+      options.fromX = int(std::strtol(argv[++i], &end, 10));
+      options.fromY = *end == ',' ? std::atoi(end + 1) : 0;
+    }
+    else if (std::strcmp(argv[i], "--to") == 0 and i + 1 < argc)
+    {
+      char* end = nullptr;
+      options.toX = int(std::strtol(argv[++i], &end, 10));
+      options.toY = *end == ',' ? std::atoi(end + 1) : -1;
+    }
+    else if (std::strcmp(argv[i], "--infinite") == 0)
+    {
+      infinite = true;
+    }
+    else if (std::strcmp(argv[i], "--chunk-size") == 0 and i + 1 < argc)
+    {
+      options.chunkSize = std::atoi(argv[++i]);
+    }
+    else if (std::strcmp(argv[i], "--tiled") == 0)
+    {
+      tiled = true;
+    }
+    else if (std::strcmp(argv[i], "--threads") == 0 and i + 1 < argc)
+    {
+      options.threadCount = std::atoi(argv[++i]);
     }
+    else if (std::strcmp(argv[i], "--tile-size") == 0 and i + 1 < argc)
+    {
+      options.tileSize = std::atoi(argv[++i]);
+    }
+    else if (std::strcmp(argv[i], "--stream") == 0)
+    {
+      // The output file is optional, without one the rows go to stdout
+      stream = true;
 
-    return index;
+      if (i + 1 < argc and argv[i + 1][0] != '-')
+      {
+        options.streamOutput = argv[++i];
+      }
+    }
+    else if (std::strcmp(argv[i], "--count") == 0 and i + 1 < argc)
+    {
+      options.mazeCount = std::atoi(argv[++i]);
+    }
+    else if (std::strcmp(argv[i], "--output") == 0 and i + 1 < argc)
+    {
+      options.outputDirectory = argv[++i];
+    }
   }
 
-  // Returns the index of the element on the top of the stack
-  int IndexOfCurrentCell()
+  // Eller keeps no state per cell, which makes it the one algorithm that fits mazes larger than the memory
+  if (not options.mappedFile.empty() and not isAlgorithmGiven)
   {
-    return unvisitedCells.top().y * mazeWidth + unvisitedCells.top().x;
+    options.algorithm = "eller";
   }
 
-  // Returns the coordinates of a cell neighbouring the current cell (top of the stack)
-  olc::vi2d CoordinatesOfNeighbour(Direction direction)
+  if (AlgorithmIndex(options.algorithm) < 0)
   {
-    olc::vi2d neighbour;
+    std::cerr << "There is no algorithm called " << options.algorithm << ", choose one of:";
 
-    switch (direction)
+    for (const std::string& name : maze::GeneratorNames())
     {
-      case NOT_SET:
-        neighbour.x = unvisitedCells.top().x;
-        neighbour.y = unvisitedCells.top().y;
-      break;
+      std::cerr << " " << name;
+    }
+
+    std::cerr << "\n";
+
+    return 1;
+  }
+
+  if (options.tileSize < 1)
+  {
+    std::cerr << "Tiles need to be at least 1x1 cells big\n";
 
-      case UP:
-        neighbour.x = unvisitedCells.top().x;
-        neighbour.y = unvisitedCells.top().y - 1;
-      break;
+    return 1;
+  }
 
-      case LEFT:
-        neighbour.x = unvisitedCells.top().x - 1;
-        neighbour.y = unvisitedCells.top().y;
-      break;
+  if (options.outputFormat != "text" and options.outputFormat != "binary" and options.outputFormat != "png")
+  {
+    std::cerr << "There is no format called " << options.outputFormat << ", choose text, binary or png\n";
 
-      case DOWN:
-        neighbour.x = unvisitedCells.top().x;
-        neighbour.y = unvisitedCells.top().y + 1;
-      break;
+    return 1;
+  }
 
-      case RIGHT:
-        neighbour.x = unvisitedCells.top().x + 1;
-        neighbour.y = unvisitedCells.top().y;
-      break;
+  if (options.pathWidth < 1 or options.pathWidth > 32)
+  {
+    std::cerr << "Paths need to be 1 to 32 pixels wide\n";
+
+    return 1;
+  }
+
+  if (options.chunkSize < 1)
+  {
+    std::cerr << "Chunks need to be at least 1x1 cells big\n";
+
+    return 1;
+  }
+
+  if (options.mazeCount < 1)
+  {
+    std::cerr << "At least 1 maze needs to be generated\n";
+
+    return 1;
+  }
+
+  if (benchmark != nullptr)
+  {
+    return RunBenchmark(benchmark, options);
+  }
+
+  if (solve and options.solver != "all" and std::find(maze::SolverNames().begin(), maze::SolverNames().end(), options.solver) == maze::SolverNames().end())
+  {
+    std::cerr << "There is no solver called " << options.solver << ", choose all or one of:";
+
+    for (const std::string& name : maze::SolverNames())
+    {
+      std::cerr << " " << name;
     }
 
-    return neighbour;
+    std::cerr << "\n";
+
+    return 1;
   }
 
-  // Returns the coordinates of the current cell (top of stack)
-  olc::vi2d CoordinatesOfCurrentCell()
+  // Solves a generated maze or the one in readFile
+  if (solve)
   {
-    return olc::vi2d{unvisitedCells.top().x, unvisitedCells.top().y};
+    return RunSolve(options);
   }
-};
 
-int main()
-{
-  MazeGenerator instance;
+  // Measures a generated maze or the one in readFile
+  if (analyze)
+  {
+    return RunAnalyze(options);
+  }
+
+  // Reading a maze file needs none of the size options
+  if (not options.readFile.empty())
+  {
+    return RunRead(options);
+  }
+
+  // The height of a streamed maze may be 0 for a maze without end
+  if (stream)
+  {
+    return RunStream(options);
+  }
+
+  if (options.mazeWidth < 1 or options.mazeHeight < 1)
+  {
+    std::cerr << "The maze needs to be at least 1x1 cells big\n";
+
+    return 1;
+  }
+
+  if (SpeedIndex(options.speed) < 0)
+  {
+    std::cerr << "There is no speed called " << options.speed << "\n";
+
+    return 1;
+  }
+
+  if (headless)
+  {
+    return RunHeadless(options);
+  }
+
+  if (tiled)
+  {
+    return RunTiled(options);
+  }
+
+  if (not options.mappedFile.empty())
+  {
+    return RunMapped(options);
+  }
+
+#if defined(OLC_PGE_HEADLESS)
+  std::cerr << "This build has no window, use --headless\n";
+
+  return 1;
+#endif
+
+  if (infinite)
+  {
+    // Printing the algorithm and seed so that the same maze can be looked at again with --algorithm and --seed
+    std::cout << options.algorithm << " seed " << options.seed << std::endl;
+
+    InfiniteViewer viewer(options);
+
+    if (viewer.Construct(401, 301 + InfiniteViewer::UISectionHeight, 2, 2))
+    {
+      viewer.Start();
+    }
+
+    return 0;
+  }
+
+  MazeGenerator instance(options);
+
+  // Each cell takes up its path plus one pixel of wall, the UI section needs at least 201 pixels
+  int screenWidth = std::max(201, options.mazeWidth * (MazeGenerator::pathWidth + 1) + 1);
+  int screenHeight = options.mazeHeight * (MazeGenerator::pathWidth + 1) + 1 + MazeGenerator::UISectionHeight;
 
-  if (instance.Construct(201, 221, 4, 4))
+  if (instance.Construct(screenWidth, screenHeight, 4, 4))
   {
     instance.Start();
   }
@@ -0,0 +1,206 @@
+#include "maze/Analytics.h"
+
+#include "maze/DistanceField.h"
+#include "maze/NeighbourMask.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+
+namespace maze
+{
+  // The cell with the largest distance, the start if no other cell can be reached
+  static std::int64_t Furthest(const std::vector<std::uint32_t>& distances, std::int64_t start)
+  {
+    std::int64_t furthest = start;
+
+    for (std::int64_t index = 0; index < std::int64_t(distances.size()); index++)
+    {
+      if (distances[index] != unreachedDistance and distances[index] > distances[furthest])
+      {
+        furthest = index;
+      }
+    }
+
+    return furthest;
+  }
+
+  MazeAnalysis AnalyzeMaze(const PackedGrid& grid, int threadCount)
+  {
+    auto start = std::chrono::steady_clock::now();
+
+    MazeAnalysis analysis;
+    analysis.cells = grid.CellCount();
+
+    const std::int64_t blockCount = grid.BlockCount();
+
+    // Corridor cells that have been followed from one of their ends already
+    std::vector<std::uint64_t> followed(blockCount, 0);
+
+    std::int64_t deadEndCorridors = 0;
+    std::int64_t deadEndCorridorSteps = 0;
+
+    // Follows the corridor that leaves the cell towards direction, the cell has any number of passages but two
+    auto followCorridor = [&](std::int64_t end, Direction direction)
+    {
+      std::int64_t previous = end;
+      std::int64_t current = grid.Neighbour(end, direction);
+      NeighbourMask passages = grid.Passages(current);
+      std::int64_t steps = 1;
+
+      // A corridor is followed from the end it is found at first, one without corridor cells from the end with the lower index
+      if (CountOf(passages) == 2 ? (followed[current >> 6] >> (current & 63)) & 1 : current < end)
+      {
+        return;
+      }
+
+      while (CountOf(passages) == 2)
+      {
+        followed[current >> 6] |= std::uint64_t(1) << (current & 63);
+
+        Direction next = NthOf(passages, 0);
+
+        if (grid.Neighbour(current, next) == previous)
+        {
+          next = NthOf(passages, 1);
+        }
+
+        previous = current;
+        current = grid.Neighbour(current, next);
+        passages = grid.Passages(current);
+        steps++;
+      }
+
+      if (std::int64_t(analysis.corridorLengths.size()) <= steps)
+      {
+        analysis.corridorLengths.resize(steps + 1, 0);
+      }
+
+      analysis.corridorLengths[steps]++;
+
+      if (CountOf(grid.Passages(end)) == 1 or CountOf(passages) == 1)
+      {
+        deadEndCorridors++;
+        deadEndCorridorSteps += steps;
+      }
+    };
+
+    for (std::int64_t block = 0; block < blockCount; block++)
+    {
+      const BlockPassages passages = grid.PassagesOfBlock(block);
+      const std::uint64_t up = passages.up;
+      const std::uint64_t left = passages.left;
+      const std::uint64_t down = passages.down;
+      const std::uint64_t right = passages.right;
+
+      // How many passages every cell has, as masks of the cells with at least one, two, three and four of them
+      // Cells past the end of the grid have none, so they fall out by themselves
+      const std::uint64_t atLeastOne = up | left | down | right;
+      const std::uint64_t atLeastTwo = (up & left) | ((up | left) & (down | right)) | (down & right);
+      const std::uint64_t atLeastThree = (up & left & (down | right)) | (down & right & (up | left));
+      const std::uint64_t four = up & left & down & right;
+
+      const std::uint64_t one = atLeastOne & ~atLeastTwo;
+      const std::uint64_t two = atLeastTwo & ~atLeastThree;
+      const std::uint64_t three = atLeastThree & ~four;
+
+      analysis.passages += std::popcount(right) + std::popcount(down);
+      analysis.deadEnds += std::popcount(one);
+      analysis.corridorCells += std::popcount(two);
+      analysis.straightCells += std::popcount(two & ((up & down) | (left & right)));
+      analysis.threeWayJunctions += std::popcount(three);
+      analysis.fourWayJunctions += std::popcount(four);
+
+      // Every corridor starts at a cell that is no corridor cell
+      for (std::uint64_t ends = one | three | four; ends != 0; ends &= ends - 1)
+      {
+        const std::int64_t end = block * 64 + std::countr_zero(ends);
+        const NeighbourMask directions = grid.Passages(end);
+
+        for (int n = 0; n < CountOf(directions); n++)
+        {
+          followCorridor(end, NthOf(directions, n));
+        }
+      }
+    }
+
+    analysis.straightness = analysis.corridorCells > 0 ? double(analysis.straightCells) / analysis.corridorCells : 0.0;
+    analysis.riverFactor = deadEndCorridors > 0 ? double(deadEndCorridorSteps) / deadEndCorridors : 0.0;
+
+    // In a tree the cell furthest from any cell is one end of a longest path, the cell furthest from that one is the other end
+    std::vector<std::uint32_t> distances;
+
+    ComputeDistanceField(grid, {0, 0}, distances, threadCount);
+    const std::int64_t first = Furthest(distances, 0);
+
+    ComputeDistanceField(grid, grid.Coordinates(first), distances, threadCount);
+    const std::int64_t second = Furthest(distances, first);
+
+    analysis.diameter = distances[second];
+    analysis.diameterStart = grid.Coordinates(first);
+    analysis.diameterEnd = grid.Coordinates(second);
+
+    analysis.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return analysis;
+  }
+
+  void WriteAnalysis(const MazeAnalysis& analysis, std::ostream& output)
+  {
+    auto share = [&](std::int64_t count)
+    {
+      return analysis.cells > 0 ? 100.0 * count / analysis.cells : 0.0;
+    };
+
+    std::int64_t corridors = 0;
+    std::int64_t corridorSteps = 0;
+
+    for (std::size_t length = 0; length < analysis.corridorLengths.size(); length++)
+    {
+      corridors += analysis.corridorLengths[length];
+      corridorSteps += std::int64_t(length) * analysis.corridorLengths[length];
+    }
+
+    char line[128];
+
+    std::snprintf(line, sizeof(line), "cells            %lld, %lld passages\n", (long long)analysis.cells, (long long)analysis.passages);
+    output << line;
+    std::snprintf(line, sizeof(line), "dead ends        %lld (%.1f%%)\n", (long long)analysis.deadEnds, share(analysis.deadEnds));
+    output << line;
+    std::snprintf(line, sizeof(line), "corridor cells   %lld (%.1f%%), %.1f%% of them straight\n", (long long)analysis.corridorCells, share(analysis.corridorCells), analysis.straightness * 100.0);
+    output << line;
+    std::snprintf(line, sizeof(line), "junctions        %lld three-way (%.1f%%), %lld four-way (%.1f%%)\n", (long long)analysis.threeWayJunctions, share(analysis.threeWayJunctions), (long long)analysis.fourWayJunctions, share(analysis.fourWayJunctions));
+    output << line;
+    std::snprintf(line, sizeof(line), "corridors        %lld, %.2f steps long on average, the longest %lld\n", (long long)corridors, corridors > 0 ? double(corridorSteps) / corridors : 0.0, (long long)(analysis.corridorLengths.empty() ? 0 : analysis.corridorLengths.size() - 1));
+    output << line;
+
+    // Lengths 1, 2-3, 4-7, ...
+    for (std::size_t first = 1; first < analysis.corridorLengths.size(); first *= 2)
+    {
+      const std::size_t last = std::min(first * 2, analysis.corridorLengths.size()) - 1;
+      std::int64_t count = 0;
+
+      for (std::size_t length = first; length <= last; length++)
+      {
+        count += analysis.corridorLengths[length];
+      }
+
+      if (first == last)
+      {
+        std::snprintf(line, sizeof(line), "  %3zu     steps  %lld\n", first, (long long)count);
+      }
+      else
+      {
+        std::snprintf(line, sizeof(line), "  %3zu-%-3zu steps  %lld\n", first, last, (long long)count);
+      }
+
+      output << line;
+    }
+
+    std::snprintf(line, sizeof(line), "diameter         %lld steps from %d,%d to %d,%d\n", (long long)analysis.diameter, analysis.diameterStart.x, analysis.diameterStart.y, analysis.diameterEnd.x, analysis.diameterEnd.y);
+    output << line;
+    std::snprintf(line, sizeof(line), "river factor     %.2f steps per dead end corridor\n", analysis.riverFactor);
+    output << line;
+  }
+}
@@ -0,0 +1,149 @@
+#include "maze/Backtracker.h"
+
+#include <stdexcept>
+#include <type_traits>
+
+namespace maze
+{
+  template<typename Grid>
+  Backtracker<Grid>::Backtracker(Grid& grid, bool isStackless) :
+    Generator<Grid>(grid),
+    isStackless(isStackless),
+    visitedCellsCounter(grid.CellCount())
+  {
+    if (isStackless and not std::is_same_v<Grid, CellGrid>)
+    {
+      throw std::invalid_argument("Only a CellGrid stores the parent pointers a stackless backtracker needs");
+    }
+
+    // The last cell has the largest index in every layout, padded ones included
+    if (not isStackless and grid.Index(grid.Width() - 1, grid.Height() - 1) > std::int64_t(UINT32_MAX))
+    {
+      throw std::invalid_argument("The backtracker supports at most 2^32 cell indices, more need a stackless one");
+    }
+  }
+
+  template<typename Grid>
+  void Backtracker<Grid>::Reset(std::uint64_t seed, Point start)
+  {
+    this->Restart(seed);
+
+    current = start;
+    currentIndex = grid.Index(start.x, start.y);
+    grid.MarkVisited(currentIndex);
+
+    visitedCellsCounter = 1;
+    peakStackSize = 0;
+    path.clear();
+
+    if (not isStackless)
+    {
+      // The stack can never get deeper than the number of cells, reserving that once means it never has to grow
+      // Pages of the reservation that the path never reaches are never touched
+      path.reserve(grid.CellCount());
+      path.push_back(std::uint32_t(currentIndex));
+      peakStackSize = 1;
+    }
+  }
+
+  template<typename Grid>
+  bool Backtracker<Grid>::Step()
+  {
+    if (IsDone())
+    {
+      return false;
+    }
+
+    // Checks if neighbours exist and if they have been visited
+    NeighbourMask neighbours = validNeighbours();
+
+    // If there are any valid neighbours choose a random one
+    if (neighbours != 0)
+    {
+      // Chooses a random neighbour from all valid neighbours
+      Direction nextCellDirection = NthOf(neighbours, random.Uniform(CountOf(neighbours)));
+
+      // Opens the wall towards the selected cell and marks it as visited
+      this->Carve(currentIndex, nextCellDirection);
+      moveCurrent(nextCellDirection);
+
+      visitedCellsCounter++;
+
+      // Push the selected cell onto the stack
+      if (not isStackless)
+      {
+        path.push_back(std::uint32_t(currentIndex));
+
+        if (path.size() > peakStackSize)
+        {
+          peakStackSize = path.size();
+        }
+      }
+    }
+    // There are no valid neighbours so we need to back-track until we find some valid ones
+    else if (isStackless)
+    {
+      // The cell points back to the cell it has been reached from, which is what the stack would pop to
+      // The starting cell has no parent but the maze is done before backtracking could get past it
+      if constexpr (std::is_same_v<Grid, CellGrid>)
+      {
+        moveCurrent(grid[currentIndex].direction);
+      }
+    }
+    else
+    {
+      path.pop_back();
+
+      // Only backtracking needs the coordinates from an index, walking forward keeps track of them
+      if (not path.empty())
+      {
+        currentIndex = path.back();
+        current = grid.Coordinates(currentIndex);
+      }
+    }
+
+    return true;
+  }
+
+  template<typename Grid>
+  void Backtracker<Grid>::Run()
+  {
+    // Step() is final here, so this loop does not go through the virtual call
+    while (Step());
+  }
+
+  template<typename Grid>
+  void Backtracker<Grid>::moveCurrent(Direction direction)
+  {
+    currentIndex = grid.Neighbour(currentIndex, direction);
+
+    switch (direction)
+    {
+      case UP: current.y--; break;
+      case LEFT: current.x--; break;
+      case DOWN: current.y++; break;
+      case RIGHT: current.x++; break;
+      default: break;
+    }
+  }
+
+  template<typename Grid>
+  NeighbourMask Backtracker<Grid>::validNeighbours() const
+  {
+    std::int64_t index = currentIndex;
+
+    // A neighbour is valid if it exists and has not been visited
+    // The bits are combined without branching, only the bounds checks guard the reads
+    return NeighbourMask(
+      (current.y > 0 and not grid.IsVisited(grid.Neighbour(index, UP))) * MaskOf(UP) |
+      (current.x > 0 and not grid.IsVisited(grid.Neighbour(index, LEFT))) * MaskOf(LEFT) |
+      (current.y < grid.Height() - 1 and not grid.IsVisited(grid.Neighbour(index, DOWN))) * MaskOf(DOWN) |
+      (current.x < grid.Width() - 1 and not grid.IsVisited(grid.Neighbour(index, RIGHT))) * MaskOf(RIGHT)
+    );
+  }
+
+  template class Backtracker<CellGrid>;
+  template class Backtracker<PackedGrid>;
+  template class Backtracker<MortonGrid>;
+  template class Backtracker<ChunkedGrid>;
+}
@@ -0,0 +1,152 @@
+#include "maze/BatchGeneration.h"
+
+#include "maze/Generator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace maze
+{
+  // The jobs a thread still has to do, other threads take from the back while the owner takes from the front
+  // Aligned to a cache line so that the owner and a thief do not fight over the neighbouring queue
+  struct alignas(64) JobQueue
+  {
+    std::mutex mutex;
+    std::int64_t begin = 0;
+    std::int64_t end = 0;
+  };
+
+  // Takes the next job of the thread's own queue, returns false if it is empty
+  static bool PopJob(JobQueue& queue, std::int64_t& job)
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.begin == queue.end)
+    {
+      return false;
+    }
+
+    job = queue.begin++;
+
+    return true;
+  }
+
+  // Moves the back half of the victim's jobs into the (empty) queue of the thief, returns false if there was nothing to take
+  static bool StealJobs(JobQueue& victim, JobQueue& thief)
+  {
+    std::int64_t begin;
+    std::int64_t end;
+
+    {
+      std::lock_guard<std::mutex> lock(victim.mutex);
+
+      if (victim.begin == victim.end)
+      {
+        return false;
+      }
+
+      begin = victim.begin + (victim.end - victim.begin) / 2;
+      end = victim.end;
+      victim.end = begin;
+    }
+
+    std::lock_guard<std::mutex> lock(thief.mutex);
+    thief.begin = begin;
+    thief.end = end;
+
+    return true;
+  }
+
+  BatchStatistics GenerateBatch(int width, int height, const std::string& algorithm, std::uint64_t seed, std::int64_t count, int threadCount, const BatchSink& sink)
+  {
+    if (threadCount < 1)
+    {
+      threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    threadCount = int(std::max<std::int64_t>(1, std::min<std::int64_t>(threadCount, count)));
+
+    BatchStatistics statistics;
+    statistics.jobSeconds.resize(count);
+    statistics.jobsPerWorker.resize(threadCount);
+    statistics.stealsPerWorker.resize(threadCount);
+
+    // Every thread starts with an equal share of the jobs
+    std::vector<JobQueue> queues(threadCount);
+
+    for (int worker = 0; worker < threadCount; worker++)
+    {
+      queues[worker].begin = count * worker / threadCount;
+      queues[worker].end = count * (worker + 1) / threadCount;
+    }
+
+    auto work = [&](int worker)
+    {
+      PackedGrid grid(width, height);
+      std::unique_ptr<Generator<PackedGrid>> generator = MakeGenerator(algorithm, grid);
+
+      while (true)
+      {
+        std::int64_t job;
+
+        if (not PopJob(queues[worker], job))
+        {
+          // Looks for work at the other threads, starting with the next one so that the thieves spread out
+          bool hasStolen = false;
+
+          for (int offset = 1; offset < threadCount and not hasStolen; offset++)
+          {
+            hasStolen = StealJobs(queues[(worker + offset) % threadCount], queues[worker]);
+          }
+
+          // Jobs are never added, so once every queue is empty the batch is done
+          if (not hasStolen)
+          {
+            return;
+          }
+
+          statistics.stealsPerWorker[worker]++;
+
+          continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        generator->Reset(seed + job);
+        generator->Run();
+
+        if (sink)
+        {
+          sink(job, grid);
+        }
+
+        statistics.jobSeconds[job] = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        statistics.jobsPerWorker[worker]++;
+      }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+
+    for (int worker = 1; worker < threadCount; worker++)
+    {
+      threads.emplace_back(work, worker);
+    }
+
+    // The calling thread is worker 0
+    work(0);
+
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+
+    statistics.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return statistics;
+  }
+}
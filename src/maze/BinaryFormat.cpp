@@ -0,0 +1,259 @@
+#include "maze/BinaryFormat.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace maze
+{
+  static constexpr char magic[8] = {'M', 'A', 'Z', 'E', 'F', 'I', 'L', 'E'};
+  static constexpr std::uint32_t version = 1;
+
+  // Turns a number into little endian and back, does nothing on little endian machines
+  template<typename Number>
+  static Number LittleEndian(Number number)
+  {
+    if constexpr (std::endian::native == std::endian::big)
+    {
+      Number swapped = 0;
+
+      for (std::size_t byte = 0; byte < sizeof(Number); byte++)
+      {
+        swapped = Number(swapped << 8) | Number(number & 0xff);
+        number = Number(number >> 8);
+      }
+
+      return swapped;
+    }
+
+    return number;
+  }
+
+  // Mixes the words of a block into one number, rotating before multiplying keeps swapped words from cancelling out
+  static std::uint64_t Checksum(const std::uint64_t* words, std::size_t count)
+  {
+    std::uint64_t checksum = 0xcbf29ce484222325;
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+      checksum = std::rotl(checksum ^ LittleEndian(words[i]), 29) * 0x9e3779b97f4a7c15;
+    }
+
+    return checksum;
+  }
+
+  static std::size_t RowBytes(int width)
+  {
+    return 2 * std::size_t((width + 63) / 64) * sizeof(std::uint64_t);
+  }
+
+  void WriteBinary(const PackedGrid& grid, std::uint64_t seed, const std::string& algorithm, std::ostream& output, int rowsPerBlock)
+  {
+    if (algorithm.size() > sizeof(MazeFileHeader::algorithm))
+    {
+      throw std::invalid_argument("The algorithm's name " + algorithm + " does not fit into a maze file");
+    }
+
+    if (rowsPerBlock < 0)
+    {
+      throw std::invalid_argument("A maze file can not have negative blocks");
+    }
+
+    const std::size_t wordsPerPlane = std::size_t((grid.Width() + 63) / 64);
+    const std::size_t rowBytes = RowBytes(grid.Width());
+    const int blockCount = rowsPerBlock > 0 ? (grid.Height() + rowsPerBlock - 1) / rowsPerBlock : 0;
+
+    MazeFileHeader header = {};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    std::memcpy(header.algorithm, algorithm.data(), algorithm.size());
+    header.version = LittleEndian(version);
+    header.rowsPerBlock = LittleEndian(std::uint32_t(rowsPerBlock));
+    header.width = LittleEndian(std::uint32_t(grid.Width()));
+    header.height = LittleEndian(std::uint32_t(grid.Height()));
+    header.seed = LittleEndian(seed);
+
+    // Rows all have the same size, so the index can go at the end and the file can still be written in one pass
+    if (blockCount > 0)
+    {
+      header.indexOffset = LittleEndian(std::uint64_t(sizeof(MazeFileHeader) + rowBytes * grid.Height()));
+    }
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<std::uint64_t> block(2 * wordsPerPlane * std::max(rowsPerBlock, 1));
+    std::vector<MazeFileBlock> index;
+    index.reserve(blockCount);
+
+    for (int y = 0; y < grid.Height(); y += std::max(rowsPerBlock, 1))
+    {
+      const int rowCount = std::min(std::max(rowsPerBlock, 1), grid.Height() - y);
+      const std::size_t wordCount = 2 * wordsPerPlane * rowCount;
+
+      for (int row = 0; row < rowCount; row++)
+      {
+        std::uint64_t* openRight = block.data() + 2 * wordsPerPlane * row;
+
+        grid.ReadRow(y + row, openRight, openRight + wordsPerPlane);
+      }
+
+      if (rowsPerBlock > 0)
+      {
+        index.push_back(MazeFileBlock{LittleEndian(std::uint64_t(sizeof(MazeFileHeader) + rowBytes * y)), LittleEndian(Checksum(block.data(), wordCount))});
+      }
+
+      for (std::size_t i = 0; i < wordCount; i++)
+      {
+        block[i] = LittleEndian(block[i]);
+      }
+
+      output.write(reinterpret_cast<const char*>(block.data()), std::streamsize(wordCount * sizeof(std::uint64_t)));
+    }
+
+    output.write(reinterpret_cast<const char*>(index.data()), std::streamsize(index.size() * sizeof(MazeFileBlock)));
+  }
+
+  bool MazeFileRows::IsPassage(int x, int y, Direction direction) const
+  {
+    switch (direction)
+    {
+      case UP: return y > 0 and IsOpenDown(x, y - 1);
+      case LEFT: return x > 0 and IsOpenRight(x - 1, y);
+      case DOWN: return IsOpenDown(x, y);
+      case RIGHT: return x < width - 1 and IsOpenRight(x, y);
+      default: return false;
+    }
+  }
+
+  MazeFile::MazeFile(const std::filesystem::path& path) :
+    file(path, MappedFile::READ_ONLY)
+  {
+    if (file.Size() < sizeof(MazeFileHeader) or std::memcmp(file.Data(), magic, sizeof(magic)) != 0)
+    {
+      throw std::runtime_error(path.string() + " is no maze file");
+    }
+
+    std::memcpy(&header, file.Data(), sizeof(header));
+    header.version = LittleEndian(header.version);
+    header.rowsPerBlock = LittleEndian(header.rowsPerBlock);
+    header.width = LittleEndian(header.width);
+    header.height = LittleEndian(header.height);
+    header.seed = LittleEndian(header.seed);
+    header.indexOffset = LittleEndian(header.indexOffset);
+
+    if (header.version != version)
+    {
+      throw std::runtime_error(path.string() + " has version " + std::to_string(header.version) + " of the maze file format, only version " + std::to_string(version) + " can be read");
+    }
+
+    // An index needs a block size and a block size needs an index, both have to fit into the int the reader counts rows with
+    if (header.width > std::uint32_t(INT32_MAX) or header.height > std::uint32_t(INT32_MAX) or header.rowsPerBlock > std::uint32_t(INT32_MAX) or HasIndex() != (header.rowsPerBlock > 0))
+    {
+      throw std::runtime_error(path.string() + " has a damaged header");
+    }
+
+    rowBytes = RowBytes(Width());
+
+    const std::uint64_t rowsEnd = sizeof(MazeFileHeader) + std::uint64_t(rowBytes) * header.height;
+    const std::uint64_t blockCount = HasIndex() ? (std::uint64_t(header.height) + header.rowsPerBlock - 1) / header.rowsPerBlock : 0;
+
+    // The size of the index is compared with the room left after its start, which can not overflow
+    if (file.Size() < rowsEnd or (HasIndex() and (header.indexOffset < rowsEnd or header.indexOffset > file.Size() or blockCount * sizeof(MazeFileBlock) > file.Size() - header.indexOffset)))
+    {
+      throw std::runtime_error(path.string() + " is cut off");
+    }
+  }
+
+  std::string MazeFile::Algorithm() const
+  {
+    return std::string(header.algorithm, strnlen(header.algorithm, sizeof(header.algorithm)));
+  }
+
+  MazeFileBlock MazeFile::Block(int block) const
+  {
+    MazeFileBlock entry;
+    std::memcpy(&entry, file.Data() + header.indexOffset + block * sizeof(MazeFileBlock), sizeof(entry));
+
+    return MazeFileBlock{LittleEndian(entry.offset), LittleEndian(entry.checksum)};
+  }
+
+  bool MazeFile::IsBlockIntact(int block) const
+  {
+    const MazeFileBlock entry = Block(block);
+    const int firstRow = block * RowsPerBlock();
+    const int rowCount = std::min(RowsPerBlock(), Height() - firstRow);
+
+    if (entry.offset != sizeof(MazeFileHeader) + rowBytes * firstRow)
+    {
+      return false;
+    }
+
+    // The rows are 8 byte aligned as long as the mapping is, which it always is
+    return Checksum(reinterpret_cast<const std::uint64_t*>(file.Data() + entry.offset), rowBytes / sizeof(std::uint64_t) * rowCount) == entry.checksum;
+  }
+
+  MazeFileRows MazeFile::Rows(int first, int end) const
+  {
+    if (first < 0 or end > Height() or first > end)
+    {
+      throw std::invalid_argument("Rows " + std::to_string(first) + " to " + std::to_string(end) + " do not lie inside a maze of height " + std::to_string(Height()));
+    }
+
+    if (HasIndex() and first < end)
+    {
+      for (int block = first / RowsPerBlock(); block <= (end - 1) / RowsPerBlock(); block++)
+      {
+        if (not IsBlockIntact(block))
+        {
+          throw std::runtime_error("Block " + std::to_string(block) + " of the maze file is damaged");
+        }
+      }
+    }
+
+    return MazeFileRows(file.Data() + sizeof(MazeFileHeader) + rowBytes * first, Width(), end - first, rowBytes);
+  }
+
+  bool MazeFile::Verify() const
+  {
+    if (not HasIndex())
+    {
+      return true;
+    }
+
+    for (int block = 0; block * RowsPerBlock() < Height(); block++)
+    {
+      if (not IsBlockIntact(block))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  PackedGrid MazeFile::Load() const
+  {
+    PackedGrid grid(Width(), Height());
+    const std::size_t wordsPerPlane = rowBytes / 2 / sizeof(std::uint64_t);
+
+    // Checks the index first
+    Rows(0, Height());
+
+    std::vector<std::uint64_t> row(2 * wordsPerPlane);
+
+    for (int y = 0; y < Height(); y++)
+    {
+      std::memcpy(row.data(), file.Data() + sizeof(MazeFileHeader) + rowBytes * y, rowBytes);
+
+      for (std::uint64_t& word : row)
+      {
+        word = LittleEndian(word);
+      }
+
+      grid.WriteRow(y, row.data(), row.data() + wordsPerPlane);
+    }
+
+    return grid;
+  }
+}
@@ -0,0 +1,76 @@
+#include "maze/CellGrid.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace maze
+{
+  CellGrid::CellGrid(int width, int height) :
+    width(width),
+    height(height)
+  {
+    if (width < 1 or height < 1)
+    {
+      throw std::invalid_argument("The maze needs to be at least 1x1 cells big");
+    }
+
+    cells.resize(CellCount());
+  }
+
+  void CellGrid::Carve(std::int64_t index, Direction direction)
+  {
+    std::int64_t neighbour = index;
+
+    switch (direction)
+    {
+      case UP: neighbour -= width; break;
+      case LEFT: neighbour -= 1; break;
+      case DOWN: neighbour += width; break;
+      case RIGHT: neighbour += 1; break;
+      default: return;
+    }
+
+    cells[neighbour].visited = true;
+    cells[neighbour].direction = Reverse(direction);
+  }
+
+  bool CellGrid::HasNeighbour(int x, int y, Direction direction) const
+  {
+    switch (direction)
+    {
+      case UP: return y > 0;
+      case LEFT: return x > 0;
+      case DOWN: return y < height - 1;
+      case RIGHT: return x < width - 1;
+      default: return false;
+    }
+  }
+
+  bool CellGrid::IsPassage(int x, int y, Direction direction) const
+  {
+    if (not HasNeighbour(x, y, direction))
+    {
+      return false;
+    }
+
+    std::int64_t index = Index(x, y);
+    std::int64_t neighbour = index;
+
+    switch (direction)
+    {
+      case UP: neighbour -= width; break;
+      case LEFT: neighbour -= 1; break;
+      case DOWN: neighbour += width; break;
+      case RIGHT: neighbour += 1; break;
+      default: break;
+    }
+
+    // The passage is stored in whichever of the two cells is the child of the other
+    return cells[index].direction == direction or cells[neighbour].direction == Reverse(direction);
+  }
+
+  void CellGrid::Clear()
+  {
+    std::fill(cells.begin(), cells.end(), cell());
+  }
+}
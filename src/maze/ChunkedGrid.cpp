@@ -0,0 +1,215 @@
+#include "maze/ChunkedGrid.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace maze
+{
+  ChunkedGrid::ChunkedGrid(int width, int height) :
+    width(width),
+    height(height)
+  {
+    if (width < 1 or height < 1)
+    {
+      throw std::invalid_argument("The maze needs to be at least 1x1 cells big");
+    }
+
+    // A power of two stride turns the coordinates into a mask and a shift, at least a whole page wide
+    strideBits = 6;
+
+    while ((std::int64_t(1) << strideBits) < width)
+    {
+      strideBits++;
+    }
+
+    strideMask = (std::int64_t(1) << strideBits) - 1;
+
+    pagesX = (width + PageSize - 1) / PageSize;
+    pagesY = (height + PageSize - 1) / PageSize;
+
+    pages.resize(std::int64_t(pagesX) * pagesY);
+    pageStates.assign(pages.size(), UNTOUCHED);
+    visitedCells.assign(pages.size(), 0);
+  }
+
+  void ChunkedGrid::Carve(std::int64_t index, Direction direction)
+  {
+    // Walls to the left and above are stored in the neighbour
+    std::int64_t neighbour = Neighbour(index, direction);
+
+    switch (direction)
+    {
+      case UP:
+        SetBit(neighbour, OPEN_DOWN);
+      break;
+
+      case LEFT:
+        SetBit(neighbour, OPEN_RIGHT);
+      break;
+
+      case DOWN:
+        SetBit(index, OPEN_DOWN);
+      break;
+
+      case RIGHT:
+        SetBit(index, OPEN_RIGHT);
+      break;
+
+      default:
+      return;
+    }
+
+    SetBit(neighbour, VISITED);
+  }
+
+  bool ChunkedGrid::HasNeighbour(int x, int y, Direction direction) const
+  {
+    switch (direction)
+    {
+      case UP: return y > 0;
+      case LEFT: return x > 0;
+      case DOWN: return y < height - 1;
+      case RIGHT: return x < width - 1;
+      default: return false;
+    }
+  }
+
+  bool ChunkedGrid::IsPassage(int x, int y, Direction direction) const
+  {
+    if (not HasNeighbour(x, y, direction))
+    {
+      return false;
+    }
+
+    std::int64_t index = Index(x, y);
+
+    switch (direction)
+    {
+      case UP: return IsOpenDown(Neighbour(index, UP));
+      case LEFT: return IsOpenRight(Neighbour(index, LEFT));
+      case DOWN: return IsOpenDown(index);
+      case RIGHT: return IsOpenRight(index);
+      default: return false;
+    }
+  }
+
+  void ChunkedGrid::Clear()
+  {
+    for (std::unique_ptr<Page>& page : pages)
+    {
+      page.reset();
+    }
+
+    std::fill(pageStates.begin(), pageStates.end(), UNTOUCHED);
+    std::fill(visitedCells.begin(), visitedCells.end(), 0);
+
+    allocatedPages = 0;
+    peakAllocatedPages = 0;
+  }
+
+  void ChunkedGrid::SetBit(std::int64_t index, Plane plane)
+  {
+    std::int64_t pageIndex = PageOf(index);
+    std::unique_ptr<Page>& page = pages[pageIndex];
+
+    // A released page can not change anymore, see SetPageSink()
+    if (pageStates[pageIndex] == RELEASED)
+    {
+      return;
+    }
+
+    // Allocated on the first write
+    if (page == nullptr)
+    {
+      page = std::make_unique<Page>();
+      pageStates[pageIndex] = ALLOCATED;
+
+      allocatedPages++;
+      peakAllocatedPages = std::max(peakAllocatedPages, allocatedPages);
+    }
+
+    std::uint64_t& word = page->words[WordOf(index, plane)];
+    std::uint64_t bit = std::uint64_t(1) << (index & 63);
+
+    if (plane != VISITED or (word & bit))
+    {
+      word |= bit;
+
+      return;
+    }
+
+    word |= bit;
+
+    // A page that just became full may finish itself and the pages to its left and above, whose release waited for it
+    if (++visitedCells[pageIndex] == CellsOfPage(pageIndex) and pageSink)
+    {
+      int pageX = int(pageIndex % pagesX);
+      int pageY = int(pageIndex / pagesX);
+
+      TryReleasePage(pageX, pageY);
+      TryReleasePage(pageX - 1, pageY);
+      TryReleasePage(pageX, pageY - 1);
+    }
+  }
+
+  void ChunkedGrid::Flush()
+  {
+    if (not pageSink)
+    {
+      return;
+    }
+
+    for (std::int64_t page = 0; page < std::int64_t(pages.size()); page++)
+    {
+      if (pageStates[page] == ALLOCATED)
+      {
+        pageSink(*this, int(page % pagesX), int(page / pagesX));
+
+        pages[page].reset();
+        pageStates[page] = RELEASED;
+        allocatedPages--;
+      }
+    }
+  }
+
+  int ChunkedGrid::CellsOfPage(std::int64_t page) const
+  {
+    int pageX = int(page % pagesX);
+    int pageY = int(page / pagesX);
+
+    return std::min(PageSize, width - pageX * PageSize) * std::min(PageSize, height - pageY * PageSize);
+  }
+
+  bool ChunkedGrid::IsPageFull(std::int64_t page) const
+  {
+    return pageStates[page] == RELEASED or visitedCells[page] == CellsOfPage(page);
+  }
+
+  void ChunkedGrid::TryReleasePage(int pageX, int pageY)
+  {
+    // The lowest row of pages waits for Flush(), the row that is being worked on could still open walls inside a full page
+    if (pageX < 0 or pageY < 0 or pageY == pagesY - 1)
+    {
+      return;
+    }
+
+    std::int64_t page = std::int64_t(pageY) * pagesX + pageX;
+
+    if (pageStates[page] != ALLOCATED or not IsPageFull(page))
+    {
+      return;
+    }
+
+    // The cells at the right and lower edge can still open a wall into an unvisited neighbour page
+    if ((pageX < pagesX - 1 and not IsPageFull(page + 1)) or (pageY < pagesY - 1 and not IsPageFull(page + pagesX)))
+    {
+      return;
+    }
+
+    pageSink(*this, pageX, pageY);
+
+    pages[page].reset();
+    pageStates[page] = RELEASED;
+    allocatedPages--;
+  }
+}
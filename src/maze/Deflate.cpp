@@ -0,0 +1,330 @@
+#include "maze/Deflate.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <array>
+#include <queue>
+
+namespace maze
+{
+  // Alphabets of RFC 1951
+  static constexpr int literalCount = 286; // Bytes, the end of a block and the lengths of back-references
+  static constexpr int distanceCount = 30;
+  static constexpr int endOfBlock = 256;
+  static constexpr int maxCodeLength = 15;
+  static constexpr std::size_t windowSize = 32768;
+
+  static constexpr std::uint16_t lengthBases[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+  static constexpr std::uint8_t lengthExtraBits[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+  static constexpr std::uint16_t distanceBases[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+  static constexpr std::uint8_t distanceExtraBits[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+  // Order in which the lengths of the code length code are written
+  static constexpr std::uint8_t codeLengthOrder[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+  // The symbol of a length or distance, the largest one whose base is not above the value
+  template<std::size_t N>
+  static int SymbolOf(const std::uint16_t (&bases)[N], std::uint32_t value)
+  {
+    return int(std::upper_bound(bases, bases + N, value) - bases) - 1;
+  }
+
+  static std::uint32_t Reversed(std::uint32_t code, int length)
+  {
+    std::uint32_t result = 0;
+
+    for (int i = 0; i < length; i++, code >>= 1)
+    {
+      result = (result << 1) | (code & 1);
+    }
+
+    return result;
+  }
+
+  // Huffman code lengths of at most maxCodeLength bits for the symbols that occur
+  // If the tree gets too deep, the frequencies are halved until it does not, which flattens it
+  static void BuildLengths(std::vector<std::uint32_t> frequencies, std::uint8_t* lengths)
+  {
+    const int symbolCount = int(frequencies.size());
+
+    while (true)
+    {
+      std::fill(lengths, lengths + symbolCount, 0);
+
+      // Nodes past symbolCount are inner nodes, the queue holds the nodes that have no parent yet ordered by weight
+      std::vector<int> parents(symbolCount, -1);
+      std::priority_queue<std::pair<std::uint64_t, int>, std::vector<std::pair<std::uint64_t, int>>, std::greater<>> roots;
+
+      for (int symbol = 0; symbol < symbolCount; symbol++)
+      {
+        if (frequencies[symbol] > 0)
+        {
+          roots.push({frequencies[symbol], symbol});
+        }
+      }
+
+      // A single symbol still needs a one bit code
+      if (roots.size() == 1)
+      {
+        lengths[roots.top().second] = 1;
+
+        return;
+      }
+
+      while (roots.size() > 1)
+      {
+        auto [firstWeight, first] = roots.top();
+        roots.pop();
+        auto [secondWeight, second] = roots.top();
+        roots.pop();
+
+        parents.push_back(-1);
+        parents[first] = parents[second] = int(parents.size()) - 1;
+        roots.push({firstWeight + secondWeight, int(parents.size()) - 1});
+      }
+
+      // Parents are always created after their children, so depths can be filled in from the root downwards
+      std::vector<std::uint8_t> depths(parents.size(), 0);
+      int maxDepth = 0;
+
+      for (int node = int(parents.size()) - 2; node >= 0; node--)
+      {
+        if (parents[node] >= 0)
+        {
+          depths[node] = std::uint8_t(depths[parents[node]] + 1);
+
+          if (node < symbolCount)
+          {
+            lengths[node] = depths[node];
+            maxDepth = std::max(maxDepth, int(depths[node]));
+          }
+        }
+      }
+
+      if (maxDepth <= maxCodeLength)
+      {
+        return;
+      }
+
+      for (std::uint32_t& frequency : frequencies)
+      {
+        frequency = frequency > 0 ? (frequency + 1) / 2 : 0;
+      }
+    }
+  }
+
+  // Canonical codes for the lengths, bit reversed because Huffman codes are written starting with their highest bit
+  static void BuildCodes(const std::uint8_t* lengths, int symbolCount, std::uint32_t* codes)
+  {
+    std::array<std::uint32_t, maxCodeLength + 1> lengthCounts = {};
+    std::array<std::uint32_t, maxCodeLength + 1> nextCodes = {};
+
+    for (int symbol = 0; symbol < symbolCount; symbol++)
+    {
+      lengthCounts[lengths[symbol]]++;
+    }
+
+    // Codes of the same length are consecutive, each length starts after the codes of the shorter ones
+    lengthCounts[0] = 0;
+
+    for (int length = 1; length <= maxCodeLength; length++)
+    {
+      nextCodes[length] = (nextCodes[length - 1] + lengthCounts[length - 1]) << 1;
+    }
+
+    for (int symbol = 0; symbol < symbolCount; symbol++)
+    {
+      if (lengths[symbol] > 0)
+      {
+        codes[symbol] = Reversed(nextCodes[lengths[symbol]]++, lengths[symbol]);
+      }
+    }
+  }
+
+  LineDeflater::LineDeflater(std::size_t lineLength, DeflateSink sink, std::size_t blockSize) :
+    lineLength(lineLength),
+    sink(std::move(sink)),
+    blockSize(blockSize),
+    previousLine(lineLength, 0),
+    canReference(lineLength >= 3 and lineLength <= windowSize)
+  {
+    // A repeated line is split so that no piece is shorter than the 3 bytes a back-reference needs
+    for (std::size_t remaining = lineLength; canReference and remaining > 0;)
+    {
+      std::size_t length = std::min<std::size_t>(258, remaining);
+
+      if (remaining - length > 0 and remaining - length < 3)
+      {
+        length = remaining - 3;
+      }
+
+      repeatLengths.push_back(std::uint16_t(length));
+      remaining -= length;
+    }
+
+    // zlib header: deflate with a 32k window, no dictionary, fastest compression
+    output = {0x78, 0x01};
+  }
+
+  void LineDeflater::AddLine(const std::uint8_t* line)
+  {
+    literals.insert(literals.end(), line, line + lineLength);
+    isRepeat.push_back(0);
+
+    std::copy(line, line + lineLength, previousLine.begin());
+    adler = adler32(adler, line, uInt(lineLength));
+
+    if (literals.size() >= blockSize)
+    {
+      WriteBlock(false);
+    }
+  }
+
+  void LineDeflater::RepeatLine()
+  {
+    if (not canReference)
+    {
+      std::vector<std::uint8_t> line = previousLine;
+      AddLine(line.data());
+
+      return;
+    }
+
+    isRepeat.push_back(1);
+    adler = adler32(adler, previousLine.data(), uInt(lineLength));
+
+    // Repeats take up little space, but a block of nothing but them still has to end at some point
+    if (isRepeat.size() >= blockSize)
+    {
+      WriteBlock(false);
+    }
+  }
+
+  void LineDeflater::Finish()
+  {
+    WriteBlock(true);
+
+    // The last block ends on a whole byte, followed by the checksum with its highest byte first
+    for (; bitCount > 0; bitCount -= 8)
+    {
+      output.push_back(std::uint8_t(bitBuffer));
+      bitBuffer >>= 8;
+    }
+
+    bitCount = 0;
+
+    for (int shift = 24; shift >= 0; shift -= 8)
+    {
+      output.push_back(std::uint8_t(adler >> shift));
+    }
+
+    sink(output.data(), output.size());
+    output.clear();
+  }
+
+  void LineDeflater::WriteBlock(bool isLast)
+  {
+    std::vector<std::uint32_t> literalFrequencies(literalCount, 0);
+    std::uint8_t literalLengths[literalCount];
+    std::uint32_t literalCodes[literalCount] = {};
+
+    for (std::uint8_t byte : literals)
+    {
+      literalFrequencies[byte]++;
+    }
+
+    literalFrequencies[endOfBlock] = 1;
+
+    const std::size_t repeatCount = std::count(isRepeat.begin(), isRepeat.end(), 1);
+
+    for (std::uint16_t length : repeatLengths)
+    {
+      literalFrequencies[257 + SymbolOf(lengthBases, length)] += std::uint32_t(repeatCount);
+    }
+
+    BuildLengths(literalFrequencies, literalLengths);
+    BuildCodes(literalLengths, literalCount, literalCodes);
+
+    // All back-references go one line back, the second code of one bit only keeps the distance code complete
+    const int distanceSymbol = canReference ? SymbolOf(distanceBases, std::uint32_t(lineLength)) : 0;
+    std::uint8_t distanceLengths[distanceCount] = {};
+    std::uint32_t distanceCodes[distanceCount] = {};
+
+    distanceLengths[distanceSymbol] = 1;
+    distanceLengths[distanceSymbol == 0 ? 1 : 0] = 1;
+    BuildCodes(distanceLengths, distanceCount, distanceCodes);
+
+    int usedLiterals = literalCount;
+    int usedDistances = distanceCount;
+
+    while (literalLengths[usedLiterals - 1] == 0)
+    {
+      usedLiterals--;
+    }
+
+    while (distanceLengths[usedDistances - 1] == 0)
+    {
+      usedDistances--;
+    }
+
+    // Block with dynamic Huffman codes
+    PutBits(isLast ? 1 : 0, 1);
+    PutBits(2, 2);
+    PutBits(std::uint32_t(usedLiterals - 257), 5);
+    PutBits(std::uint32_t(usedDistances - 1), 5);
+    PutBits(19 - 4, 4);
+
+    // The code lengths themselves use a code that gives each of the lengths 0 to 15 four bits, so no run-length symbols are needed
+    for (std::uint8_t symbol : codeLengthOrder)
+    {
+      PutBits(symbol < 16 ? 4 : 0, 3);
+    }
+
+    for (int symbol = 0; symbol < usedLiterals; symbol++)
+    {
+      PutBits(Reversed(literalLengths[symbol], 4), 4);
+    }
+
+    for (int symbol = 0; symbol < usedDistances; symbol++)
+    {
+      PutBits(Reversed(distanceLengths[symbol], 4), 4);
+    }
+
+    const std::uint8_t* literal = literals.data();
+
+    for (std::uint8_t repeat : isRepeat)
+    {
+      if (repeat)
+      {
+        for (std::uint16_t length : repeatLengths)
+        {
+          int lengthSymbol = SymbolOf(lengthBases, length);
+
+          PutBits(literalCodes[257 + lengthSymbol], literalLengths[257 + lengthSymbol]);
+          PutBits(length - lengthBases[lengthSymbol], lengthExtraBits[lengthSymbol]);
+          PutBits(distanceCodes[distanceSymbol], distanceLengths[distanceSymbol]);
+          PutBits(std::uint32_t(lineLength - distanceBases[distanceSymbol]), distanceExtraBits[distanceSymbol]);
+        }
+
+        continue;
+      }
+
+      for (const std::uint8_t* end = literal + lineLength; literal < end; literal++)
+      {
+        PutBits(literalCodes[*literal], literalLengths[*literal]);
+      }
+    }
+
+    PutBits(literalCodes[endOfBlock], literalLengths[endOfBlock]);
+
+    literals.clear();
+    isRepeat.clear();
+
+    if (not isLast and output.size() >= blockSize)
+    {
+      sink(output.data(), output.size());
+      output.clear();
+    }
+  }
+}
@@ -0,0 +1,231 @@
+#include "maze/DistanceField.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace maze
+{
+  // The cells a thread has put up for others to take
+  // Aligned to a cache line so that the owner and a thief do not fight over the neighbouring queue
+  struct alignas(64) CellQueue
+  {
+    std::mutex mutex;
+    std::vector<std::int64_t> cells;
+    std::atomic<std::size_t> size = 0; // Read without the lock to skip empty queues
+  };
+
+  // Moves half of the queue's cells onto the stack, returns false if there was nothing to take
+  static bool TakeCells(CellQueue& queue, std::vector<std::int64_t>& stack)
+  {
+    if (queue.size.load(std::memory_order_relaxed) == 0)
+    {
+      return false;
+    }
+
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.cells.empty())
+    {
+      return false;
+    }
+
+    const std::size_t kept = queue.cells.size() / 2;
+    stack.insert(stack.end(), queue.cells.begin() + kept, queue.cells.end());
+    queue.cells.resize(kept);
+    queue.size.store(kept, std::memory_order_relaxed);
+
+    return true;
+  }
+
+  DistanceFieldStatistics ComputeDistanceField(const PackedGrid& grid, Point start, std::vector<std::uint32_t>& distances, int threadCount)
+  {
+    if (start.x < 0 or start.y < 0 or start.x >= grid.Width() or start.y >= grid.Height())
+    {
+      throw std::invalid_argument("The start does not lie inside the maze");
+    }
+
+    if (threadCount < 1)
+    {
+      threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    DistanceFieldStatistics statistics;
+    statistics.cellsPerWorker.resize(threadCount);
+    statistics.stealsPerWorker.resize(threadCount);
+
+    const std::int64_t width = grid.Width();
+    const std::int64_t startIndex = grid.Index(start.x, start.y);
+
+    auto begin = std::chrono::steady_clock::now();
+
+    distances.assign(grid.CellCount(), unreachedDistance);
+    distances[startIndex] = 0;
+
+    std::vector<CellQueue> queues(threadCount);
+    queues[0].cells.push_back(startIndex);
+    queues[0].size = 1;
+
+    // Once every thread is idle at the same time, no thread holds any cells and nothing can be shared anymore
+    std::atomic<int> idleCount = 0;
+
+    // Set as soon as a cell is lowered that had been reached before, from then on every thread takes its oldest cells first
+    std::atomic<bool> hasLoops = false;
+
+    auto work = [&](int worker)
+    {
+      std::vector<std::int64_t> stack;
+      std::size_t oldest = 0; // Cells of the stack before it have been taken already, only ever above 0 while taking the oldest first
+      std::int64_t expanded = 0;
+
+      // Lowers the distance of a neighbour and goes on from it, threads may race for the same cell in a maze with loops
+      auto relax = [&](std::int64_t neighbour, std::uint32_t distance)
+      {
+        std::atomic_ref<std::uint32_t> target(distances[neighbour]);
+        std::uint32_t current = target.load(std::memory_order_relaxed);
+
+        while (distance < current)
+        {
+          if (target.compare_exchange_weak(current, distance, std::memory_order_relaxed))
+          {
+            if (current != unreachedDistance and not hasLoops.load(std::memory_order_relaxed))
+            {
+              hasLoops.store(true, std::memory_order_relaxed);
+            }
+
+            stack.push_back(neighbour);
+
+            return;
+          }
+        }
+      };
+
+      // Takes cells from the own queue first and then from the others, starting with the next one so that the thieves spread out
+      auto takeCells = [&]()
+      {
+        if (TakeCells(queues[worker], stack))
+        {
+          return true;
+        }
+
+        for (int offset = 1; offset < threadCount; offset++)
+        {
+          if (TakeCells(queues[(worker + offset) % threadCount], stack))
+          {
+            statistics.stealsPerWorker[worker]++;
+
+            return true;
+          }
+        }
+
+        return false;
+      };
+
+      while (true)
+      {
+        if (stack.empty() and not takeCells())
+        {
+          idleCount++;
+
+          while (not takeCells())
+          {
+            if (idleCount.load() == threadCount)
+            {
+              statistics.cellsPerWorker[worker] = expanded;
+
+              return;
+            }
+
+            std::this_thread::yield();
+          }
+
+          idleCount--;
+        }
+
+        // Newest first walks the maze depth first and piles up the cells of side passages for other threads to take
+        // Oldest first keeps a maze with loops close to breadth first order, where few cells are lowered more than once
+        std::int64_t index;
+
+        if (hasLoops.load(std::memory_order_relaxed))
+        {
+          index = stack[oldest++];
+
+          // Drops the cells that have been taken once they make up most of the stack
+          if (oldest == stack.size() or (oldest >= 1024 and oldest > stack.size() / 2))
+          {
+            stack.erase(stack.begin(), stack.begin() + oldest);
+            oldest = 0;
+          }
+        }
+        else
+        {
+          index = stack.back();
+          stack.pop_back();
+        }
+
+        const std::uint32_t distance = std::atomic_ref<std::uint32_t>(distances[index]).load(std::memory_order_relaxed) + 1;
+        expanded++;
+
+        // The last cell of a row is never open to the right and the last row never downwards
+        if (index >= width and grid.IsOpenDown(index - width))
+        {
+          relax(index - width, distance);
+        }
+
+        if (index > 0 and grid.IsOpenRight(index - 1))
+        {
+          relax(index - 1, distance);
+        }
+
+        if (grid.IsOpenDown(index))
+        {
+          relax(index + width, distance);
+        }
+
+        if (grid.IsOpenRight(index))
+        {
+          relax(index + 1, distance);
+        }
+
+        // The oldest cells lead into the largest unexplored parts, they are shared once the own queue has been taken
+        if (threadCount > 1 and stack.size() - oldest >= 64 and queues[worker].size.load(std::memory_order_relaxed) == 0)
+        {
+          const auto first = stack.begin() + oldest;
+          const auto end = first + (stack.size() - oldest) / 2;
+
+          std::lock_guard<std::mutex> lock(queues[worker].mutex);
+          queues[worker].cells.insert(queues[worker].cells.end(), first, end);
+          queues[worker].size.store(queues[worker].cells.size(), std::memory_order_relaxed);
+          stack.erase(first, end);
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (int worker = 1; worker < threadCount; worker++)
+    {
+      threads.emplace_back(work, worker);
+    }
+
+    // The calling thread is worker 0
+    work(0);
+
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+
+    statistics.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    for (std::uint32_t distance : distances)
+    {
+      statistics.maximumDistance = std::max(statistics.maximumDistance, distance == unreachedDistance ? 0 : distance);
+    }
+
+    return statistics;
+  }
+}
@@ -0,0 +1,236 @@
+#include "maze/DistanceIndex.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <utility>
+
+namespace maze
+{
+  DistanceIndex::DistanceIndex(const PackedGrid& grid, Point root) :
+    grid(grid)
+  {
+    if (grid.CellCount() >= (std::int64_t(1) << 32))
+    {
+      throw std::invalid_argument("A distance index needs a maze with less than 2^32 cells");
+    }
+
+    if (root.x < 0 or root.y < 0 or root.x >= grid.Width() or root.y >= grid.Height())
+    {
+      throw std::invalid_argument("The root does not lie inside the maze");
+    }
+
+    positions.assign(grid.CellCount(), unreached);
+    cells.reserve(grid.CellCount());
+    depths.reserve(grid.CellCount());
+
+    // Depth first through the passages, a cell gets its position when it is taken off the stack
+    // Each cell but the root is pushed once by its parent, so its subtree follows it without gaps
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> stack = {{std::uint32_t(grid.Index(root.x, root.y)), 0}};
+
+    while (not stack.empty())
+    {
+      auto [index, depth] = stack.back();
+      stack.pop_back();
+
+      // Only a maze with loops reaches a cell twice
+      if (positions[index] != unreached)
+      {
+        continue;
+      }
+
+      positions[index] = std::uint32_t(cells.size());
+      cells.push_back(index);
+      depths.push_back(depth);
+
+      const Point cell = grid.Coordinates(index);
+
+      for (int direction = UP; direction <= RIGHT; direction++)
+      {
+        if (grid.IsPassage(cell.x, cell.y, Direction(direction)))
+        {
+          const std::int64_t neighbour = grid.Neighbour(index, Direction(direction));
+
+          if (positions[neighbour] == unreached)
+          {
+            stack.push_back({std::uint32_t(neighbour), depth + 1});
+          }
+        }
+      }
+    }
+
+    const std::size_t count = cells.size();
+    minimumMasks.resize(count);
+
+    // Inside a block the mask works like a stack of ever deeper positions, a new position removes the ones that are not shallower than it
+    for (std::size_t position = 0; position < count; position++)
+    {
+      std::uint64_t mask = position % 64 == 0 ? 0 : minimumMasks[position - 1];
+
+      while (mask != 0 and depths[(position & ~std::size_t(63)) + 63 - std::countl_zero(mask)] >= depths[position])
+      {
+        mask &= ~(std::uint64_t(1) << (63 - std::countl_zero(mask)));
+      }
+
+      minimumMasks[position] = mask | std::uint64_t(1) << (position % 64);
+    }
+
+    // Row 0 is each block's shallowest position, which is the lowest bit of the mask of its last position
+    blockCount = (count + 63) / 64;
+    const int rowCount = blockCount > 0 ? std::bit_width(blockCount) : 0;
+    blockMinimums.resize(rowCount * blockCount);
+
+    for (std::size_t block = 0; block < blockCount; block++)
+    {
+      const std::size_t last = std::min(block * 64 + 63, count - 1);
+      blockMinimums[block] = std::uint32_t(block * 64 + std::countr_zero(minimumMasks[last]));
+    }
+
+    for (int row = 1; row < rowCount; row++)
+    {
+      const std::size_t half = std::size_t(1) << (row - 1);
+
+      for (std::size_t block = 0; block + 2 * half <= blockCount; block++)
+      {
+        blockMinimums[row * blockCount + block] = Shallower(blockMinimums[(row - 1) * blockCount + block], blockMinimums[(row - 1) * blockCount + block + half]);
+      }
+    }
+  }
+
+  std::int64_t DistanceIndex::Depth(std::int64_t index) const
+  {
+    return positions[index] == unreached ? -1 : depths[positions[index]];
+  }
+
+  std::int64_t DistanceIndex::CommonAncestor(std::int64_t a, std::int64_t b) const
+  {
+    std::uint32_t first = positions[a];
+    std::uint32_t last = positions[b];
+
+    if (first == unreached or last == unreached)
+    {
+      return -1;
+    }
+
+    if (first == last)
+    {
+      return a;
+    }
+
+    if (first > last)
+    {
+      std::swap(first, last);
+    }
+
+    return Parent(cells[Minimum(first + 1, last)]);
+  }
+
+  std::int64_t DistanceIndex::Distance(std::int64_t a, std::int64_t b) const
+  {
+    std::uint32_t first = positions[a];
+    std::uint32_t last = positions[b];
+
+    if (first == unreached or last == unreached)
+    {
+      return -1;
+    }
+
+    if (first == last)
+    {
+      return 0;
+    }
+
+    if (first > last)
+    {
+      std::swap(first, last);
+    }
+
+    // The shallowest cell between them is a child of the common ancestor
+    const std::int64_t ancestorDepth = std::int64_t(depths[Minimum(first + 1, last)]) - 1;
+
+    return depths[first] + depths[last] - 2 * ancestorDepth;
+  }
+
+  std::vector<std::int64_t> DistanceIndex::Path(std::int64_t a, std::int64_t b) const
+  {
+    const std::int64_t ancestor = CommonAncestor(a, b);
+
+    if (ancestor < 0)
+    {
+      return {};
+    }
+
+    // Up from a to the ancestor, then up from b to just below it the other way round
+    std::vector<std::int64_t> path;
+    path.reserve(Distance(a, b) + 1);
+
+    for (std::int64_t index = a; index != ancestor; index = Parent(index))
+    {
+      path.push_back(index);
+    }
+
+    path.push_back(ancestor);
+    const std::size_t turn = path.size();
+
+    for (std::int64_t index = b; index != ancestor; index = Parent(index))
+    {
+      path.push_back(index);
+    }
+
+    std::reverse(path.begin() + turn, path.end());
+
+    return path;
+  }
+
+  std::size_t DistanceIndex::MemoryUsage() const
+  {
+    return (positions.capacity() + cells.capacity() + depths.capacity() + blockMinimums.capacity()) * sizeof(std::uint32_t) + minimumMasks.capacity() * sizeof(std::uint64_t);
+  }
+
+  std::int64_t DistanceIndex::Parent(std::int64_t index) const
+  {
+    const Point cell = grid.Coordinates(index);
+    const std::int64_t depth = Depth(index);
+
+    for (int direction = UP; direction <= RIGHT; direction++)
+    {
+      if (grid.IsPassage(cell.x, cell.y, Direction(direction)) and Depth(grid.Neighbour(index, Direction(direction))) == depth - 1)
+      {
+        return grid.Neighbour(index, Direction(direction));
+      }
+    }
+
+    return index;
+  }
+
+  std::uint32_t DistanceIndex::Minimum(std::uint32_t first, std::uint32_t last) const
+  {
+    // The lowest bit of a mask at or after a position is the shallowest cell from there
+    auto inBlock = [this](std::uint32_t first, std::uint32_t last)
+    {
+      return (last & ~std::uint32_t(63)) + std::uint32_t(std::countr_zero(minimumMasks[last] & (~std::uint64_t(0) << (first & 63))));
+    };
+
+    const std::size_t firstBlock = first / 64;
+    const std::size_t lastBlock = last / 64;
+
+    if (firstBlock == lastBlock)
+    {
+      return inBlock(first, last);
+    }
+
+    std::uint32_t minimum = Shallower(inBlock(first, std::uint32_t(firstBlock * 64 + 63)), inBlock(std::uint32_t(lastBlock * 64), last));
+
+    // The blocks in between are covered by two rows of the sparse table that may overlap
+    if (lastBlock - firstBlock > 1)
+    {
+      const std::size_t between = lastBlock - firstBlock - 1;
+      const int row = std::bit_width(between) - 1;
+
+      minimum = Shallower(minimum, blockMinimums[row * blockCount + firstBlock + 1]);
+      minimum = Shallower(minimum, blockMinimums[row * blockCount + lastBlock - (std::size_t(1) << row)]);
+    }
+
+    return minimum;
+  }
+}
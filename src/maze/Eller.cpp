@@ -0,0 +1,140 @@
+#include "maze/Eller.h"
+
+namespace maze
+{
+  template<typename Grid>
+  Eller<Grid>::Eller(Grid& grid) :
+    Generator<Grid>(grid),
+    stream(grid.Width(), 0)
+  {}
+
+  template<typename Grid>
+  void Eller<Grid>::Reset(std::uint64_t seed)
+  {
+    this->Restart(seed);
+
+    stream = EllerStream(grid.Width(), seed);
+    row = -1;
+
+    StartNextRow();
+
+    // A maze with a single cell has no walls to open
+    if (grid.CellCount() == 1)
+    {
+      grid.MarkVisited(0);
+      row = 1;
+    }
+  }
+
+  template<typename Grid>
+  bool Eller<Grid>::Step()
+  {
+    if (IsDone())
+    {
+      return false;
+    }
+
+    lastCarving = Carving();
+
+    const int width = grid.Width();
+    std::int64_t index = grid.Index(column, row);
+
+    if (phase == JOINING_RIGHT)
+    {
+      grid.MarkVisited(index);
+
+      if (column < width - 1)
+      {
+        if (currentRow->IsOpenRight(column))
+        {
+          this->Carve(index, RIGHT);
+        }
+
+        column++;
+
+        return true;
+      }
+
+      if (row == grid.Height() - 1)
+      {
+        row++;
+
+        return true;
+      }
+
+      phase = OPENING_DOWN;
+      column = 0;
+
+      return true;
+    }
+
+    if (currentRow->IsOpenDown(column))
+    {
+      this->Carve(index, DOWN);
+    }
+
+    column++;
+
+    if (column == width)
+    {
+      StartNextRow();
+    }
+
+    return true;
+  }
+
+  template<typename Grid>
+  void Eller<Grid>::Run()
+  {
+    // Finishes the row that steps have been taken in already, then carves whole rows without going through the steps
+    while (not IsDone() and (column != 0 or phase != JOINING_RIGHT))
+    {
+      Step();
+    }
+
+    const int width = grid.Width();
+
+    while (not IsDone())
+    {
+      for (int x = 0; x < width; x++)
+      {
+        grid.MarkVisited(grid.Index(x, row));
+
+        if (x < width - 1 and currentRow->IsOpenRight(x))
+        {
+          this->Carve(grid.Index(x, row), RIGHT);
+        }
+      }
+
+      if (row == grid.Height() - 1)
+      {
+        row++;
+
+        break;
+      }
+
+      for (int x = 0; x < width; x++)
+      {
+        if (currentRow->IsOpenDown(x))
+        {
+          this->Carve(grid.Index(x, row), DOWN);
+        }
+      }
+
+      StartNextRow();
+    }
+  }
+
+  template<typename Grid>
+  void Eller<Grid>::StartNextRow()
+  {
+    row++;
+    column = 0;
+    phase = JOINING_RIGHT;
+
+    currentRow = &stream.NextRow(row == grid.Height() - 1);
+  }
+
+  template class Eller<PackedGrid>;
+  template class Eller<ChunkedGrid>;
+}
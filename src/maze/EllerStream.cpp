@@ -0,0 +1,132 @@
+#include "maze/EllerStream.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace maze
+{
+  EllerStream::EllerStream(int width, std::uint64_t seed) :
+    width(width),
+    random(seed)
+  {
+    if (width < 1)
+    {
+      throw std::invalid_argument("The maze needs to be at least 1 cell wide");
+    }
+
+    row = MazeRow(width);
+    sets.resize(width);
+    parents.resize(2 * width);
+    remainingCells.assign(2 * width, 0);
+    nextSets.resize(width);
+    hasPassageDown.assign(2 * width, false);
+
+    // Every cell of the first row starts in its own set
+    for (int x = 0; x < width; x++)
+    {
+      sets[x] = x;
+    }
+
+    for (int set = 0; set < 2 * width; set++)
+    {
+      parents[set] = set;
+    }
+  }
+
+  const MazeRow& EllerStream::NextRow(bool isLastRow)
+  {
+    std::fill(row.openRight.begin(), row.openRight.end(), 0);
+    std::fill(row.openDown.begin(), row.openDown.end(), 0);
+    row.y++;
+
+    // Joining neighbouring sets, the last row has to join everything, other rows join at random
+    for (int x = 0; x < width - 1; x++)
+    {
+      std::uint32_t set = Find(sets[x]);
+      std::uint32_t rightSet = Find(sets[x + 1]);
+
+      if (set != rightSet and (isLastRow or (random() & 1)))
+      {
+        parents[rightSet] = set;
+        row.openRight[x >> 6] |= std::uint64_t(1) << (x & 63);
+      }
+    }
+
+    if (isLastRow)
+    {
+      return row;
+    }
+
+    for (int x = 0; x < width; x++)
+    {
+      remainingCells[Find(sets[x])]++;
+    }
+
+    // Opening walls downwards, the last cell of a set that has none yet has to open one
+    for (int x = 0; x < width; x++)
+    {
+      std::uint32_t set = Find(sets[x]);
+
+      remainingCells[set]--;
+
+      if ((random() & 1) or (remainingCells[set] == 0 and not hasPassageDown[set]))
+      {
+        hasPassageDown[set] = true;
+        nextSets[x] = set;
+        row.openDown[x >> 6] |= std::uint64_t(1) << (x & 63);
+      }
+      else
+      {
+        // A cell without a passage from above starts a new set, numbers from width upwards are unused in this row
+        nextSets[x] = width + x;
+      }
+    }
+
+    StartNextRow();
+
+    return row;
+  }
+
+  std::size_t EllerStream::MemoryUsage() const
+  {
+    return (sets.capacity() + parents.capacity() + remainingCells.capacity() + nextSets.capacity()) * sizeof(std::uint32_t) + (hasPassageDown.capacity() + 7) / 8 + (row.openRight.capacity() + row.openDown.capacity()) * sizeof(std::uint64_t);
+  }
+
+  std::uint32_t EllerStream::Find(std::uint32_t set)
+  {
+    while (parents[set] != set)
+    {
+      parents[set] = parents[parents[set]];
+      set = parents[set];
+    }
+
+    return set;
+  }
+
+  void EllerStream::StartNextRow()
+  {
+    // Renumbers the sets to 0 .. width - 1 so that width .. 2 * width - 1 are free again for the next row
+    std::vector<std::uint32_t>& renumbered = remainingCells;
+    std::fill(renumbered.begin(), renumbered.end(), UINT32_MAX);
+
+    std::uint32_t nextNumber = 0;
+
+    for (int x = 0; x < width; x++)
+    {
+      if (renumbered[nextSets[x]] == UINT32_MAX)
+      {
+        renumbered[nextSets[x]] = nextNumber++;
+      }
+
+      sets[x] = renumbered[nextSets[x]];
+    }
+
+    for (int set = 0; set < 2 * width; set++)
+    {
+      parents[set] = set;
+      remainingCells[set] = 0;
+    }
+
+    std::fill(hasPassageDown.begin(), hasPassageDown.end(), false);
+  }
+}
@@ -0,0 +1,55 @@
+#include "maze/Generator.h"
+
+#include "maze/Backtracker.h"
+#include "maze/Eller.h"
+#include "maze/GrowingTree.h"
+#include "maze/Kruskal.h"
+#include "maze/Prim.h"
+#include "maze/Wilson.h"
+
+namespace maze
+{
+  const std::vector<std::string>& GeneratorNames()
+  {
+    static const std::vector<std::string> names = {
+      "backtracker",
+      "kruskal",
+      "prim",
+      "wilson",
+      "eller",
+      "growing-tree"
+    };
+
+    return names;
+  }
+
+  std::unique_ptr<Generator<PackedGrid>> MakeGenerator(const std::string& name, PackedGrid& grid)
+  {
+    if (name == "backtracker")
+    {
+      return std::make_unique<Backtracker<PackedGrid>>(grid);
+    }
+    else if (name == "kruskal")
+    {
+      return std::make_unique<Kruskal>(grid);
+    }
+    else if (name == "prim")
+    {
+      return std::make_unique<Prim>(grid);
+    }
+    else if (name == "wilson")
+    {
+      return std::make_unique<Wilson>(grid);
+    }
+    else if (name == "eller")
+    {
+      return std::make_unique<Eller<PackedGrid>>(grid);
+    }
+    else if (name == "growing-tree")
+    {
+      return std::make_unique<GrowingTree>(grid);
+    }
+
+    return nullptr;
+  }
+}
@@ -0,0 +1,97 @@
+#include "maze/GrowingTree.h"
+
+#include <algorithm>
+
+namespace maze
+{
+  GrowingTree::GrowingTree(PackedGrid& grid, float newestChance) :
+    Generator<PackedGrid>(grid),
+    newestThreshold(std::uint32_t(newestChance * 65536.0f))
+  {}
+
+  void GrowingTree::Reset(std::uint64_t seed)
+  {
+    Restart(seed);
+
+    activeCells.clear();
+    retiredCount = 0;
+    peakActiveCells = 1;
+
+    currentCell = 0;
+    grid.MarkVisited(currentCell);
+    activeCells.push_back(currentCell);
+  }
+
+  bool GrowingTree::Step()
+  {
+    if (IsDone())
+    {
+      return false;
+    }
+
+    lastCarving = Carving();
+
+    // Chooses between the newest and a random active cell
+    std::size_t position = activeCells.size() - 1;
+
+    // At most half of the list are retired cells, so a random pick lands on an active one within two tries on average
+    if (random.Uniform(65536) >= newestThreshold)
+    {
+      do
+      {
+        position = random.Uniform(std::uint32_t(activeCells.size()));
+      }
+      while (activeCells[position] < 0);
+    }
+
+    currentCell = activeCells[position];
+
+    NeighbourMask unvisitedNeighbours = grid.VisitedNeighbours(currentCell, false);
+
+    // Extends the cell into a random unvisited neighbour, which becomes the newest active cell
+    if (unvisitedNeighbours != 0)
+    {
+      Direction direction = NthOf(unvisitedNeighbours, random.Uniform(CountOf(unvisitedNeighbours)));
+
+      Carve(currentCell, direction);
+
+      activeCells.push_back(grid.Neighbour(currentCell, direction));
+
+      if (activeCells.size() > peakActiveCells)
+      {
+        peakActiveCells = activeCells.size();
+      }
+    }
+    // The newest cell retires from the end, together with retired cells that end up behind it
+    else if (position == activeCells.size() - 1)
+    {
+      activeCells.pop_back();
+
+      while (not activeCells.empty() and activeCells.back() < 0)
+      {
+        activeCells.pop_back();
+        retiredCount--;
+      }
+    }
+    // Any other cell keeps its place as -1, so that the order of the active cells and with it the newest one stays intact
+    else
+    {
+      activeCells[position] = -1;
+      retiredCount++;
+
+      if (2 * retiredCount > activeCells.size())
+      {
+        activeCells.erase(std::remove(activeCells.begin(), activeCells.end(), -1), activeCells.end());
+        retiredCount = 0;
+      }
+    }
+
+    return true;
+  }
+
+  void GrowingTree::Run()
+  {
+    // Step() is final here, so this loop does not go through the virtual call
+    while (Step());
+  }
+}
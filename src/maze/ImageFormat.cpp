@@ -0,0 +1,216 @@
+#include "maze/ImageFormat.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace maze
+{
+  // PNG filter type of every pixel row, the bytes are written as they are
+  static constexpr std::uint8_t noFilter = 0;
+
+  static void PutBigEndian(std::uint8_t* bytes, std::uint32_t number)
+  {
+    bytes[0] = std::uint8_t(number >> 24);
+    bytes[1] = std::uint8_t(number >> 16);
+    bytes[2] = std::uint8_t(number >> 8);
+    bytes[3] = std::uint8_t(number);
+  }
+
+  // Image size in pixels of a maze, throws std::invalid_argument if it is larger than a PNG can be
+  static std::int64_t ImageSize(int cells, int pathWidth)
+  {
+    if (cells < 1 or pathWidth < 1 or pathWidth > 32)
+    {
+      throw std::invalid_argument("A maze image needs at least 1x1 cells and a path width of 1 to 32 pixels");
+    }
+
+    const std::int64_t pixels = std::int64_t(cells) * (pathWidth + 1) + 1;
+
+    if (pixels > INT32_MAX)
+    {
+      throw std::invalid_argument("A PNG can not be larger than 2^31 - 1 pixels in either direction");
+    }
+
+    return pixels;
+  }
+
+  // Pixels of every combination of 8 cells, each cell drawing pathWidth + 1 pixels of set or clear with the first pixel in the highest bit
+  static std::vector<std::uint8_t> BuildPatterns(int pathWidth, std::uint64_t set, std::uint64_t clear)
+  {
+    std::vector<std::uint8_t> patterns(256 * 8, 0);
+
+    for (int cells = 0; cells < 256; cells++)
+    {
+      std::uint64_t bits = 0;
+
+      for (int cell = 0; cell < 8; cell++)
+      {
+        bits = (bits << (pathWidth + 1)) | ((cells >> cell) & 1 ? set : clear);
+      }
+
+      for (int byte = 0; byte < pathWidth + 1; byte++)
+      {
+        patterns[cells * 8 + byte] = std::uint8_t(bits >> (8 * (pathWidth - byte)));
+      }
+    }
+
+    return patterns;
+  }
+
+  MazeImage::MazeImage(std::ostream& output, int width, int height, int pathWidth) :
+    output(output),
+    width(width),
+    height(height),
+    pathWidth(pathWidth),
+    lineLength(1 + std::size_t((ImageSize(width, pathWidth) + 7) / 8)),
+    line(lineLength + 8, 0),
+    openLeft((width + 63) / 64, 0),
+    deflater(lineLength, [this](const std::uint8_t* data, std::size_t length) { WriteChunk("IDAT", data, length); })
+  {
+    const std::int64_t imageHeight = ImageSize(height, pathWidth);
+
+    // Up to 7 pixels of path and one of wall fit 8 cells into a 64 bit pattern
+    if (pathWidth < 8)
+    {
+      cellPatterns = BuildPatterns(pathWidth, CellPixels(true), CellPixels(false));
+      wallPatterns = BuildPatterns(pathWidth, WallPixels(true), WallPixels(false));
+    }
+
+    static constexpr std::uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    this->output.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+    // One bit greyscale, no interlacing
+    std::uint8_t header[13] = {};
+    PutBigEndian(header, std::uint32_t(ImageSize(width, pathWidth)));
+    PutBigEndian(header + 4, std::uint32_t(imageHeight));
+    header[8] = 1;
+    WriteChunk("IHDR", header, sizeof(header));
+
+    // The top border is a black row
+    deflater.AddLine(line.data());
+  }
+
+  void MazeImage::AddRow(const std::uint64_t* openRight, const std::uint64_t* openDown)
+  {
+    if (rowCount == height)
+    {
+      throw std::runtime_error("The maze image already has all of its " + std::to_string(height) + " rows");
+    }
+
+    const bool isLastRow = ++rowCount == height;
+
+    // A cell is open to the left if the cell before it is open to the right
+    for (std::size_t word = 0; word < openLeft.size(); word++)
+    {
+      openLeft[word] = (openRight[word] << 1) | (word > 0 ? openRight[word - 1] >> 63 : 0);
+    }
+
+    // The cells and the walls to their left
+    Draw(openLeft.data(), cellPatterns, CellPixels(true), CellPixels(false));
+    deflater.AddLine(line.data());
+
+    // The rest of the cells' pixel rows are the same
+    for (int i = 1; i < pathWidth; i++)
+    {
+      deflater.RepeatLine();
+    }
+
+    // The corners and the walls below the cells, the bottom border is closed
+    if (isLastRow)
+    {
+      std::fill(line.begin(), line.end(), 0);
+    }
+    else
+    {
+      Draw(openDown, wallPatterns, WallPixels(true), WallPixels(false));
+    }
+
+    deflater.AddLine(line.data());
+
+    if (isLastRow)
+    {
+      deflater.Finish();
+      WriteChunk("IEND", nullptr, 0);
+    }
+  }
+
+  void MazeImage::Draw(const std::uint64_t* cells, const std::vector<std::uint8_t>& patterns, std::uint64_t set, std::uint64_t clear)
+  {
+    const int cellBits = pathWidth + 1;
+    std::uint8_t* pixels = line.data() + 1;
+
+    line[0] = noFilter;
+
+    if (not patterns.empty())
+    {
+      // 8 cells take up exactly pathWidth + 1 bytes, so every group starts on a whole byte
+      for (int x = 0; x < width; x += 8, pixels += cellBits)
+      {
+        std::memcpy(pixels, &patterns[((cells[x >> 6] >> (x & 63)) & 0xff) * 8], 8);
+      }
+    }
+    else
+    {
+      // Pixels are packed from the most significant bit on, the accumulator only ever needs its lowest count bits
+      std::uint64_t bits = 0;
+      int count = 0;
+
+      for (int x = 0; x < width; x++)
+      {
+        std::uint64_t isSet = (cells[x >> 6] >> (x & 63)) & 1;
+        bits = (bits << cellBits) | (clear ^ ((set ^ clear) & (0 - isSet)));
+        count += cellBits;
+
+        for (; count >= 8; count -= 8)
+        {
+          *pixels++ = std::uint8_t(bits >> (count - 8));
+        }
+      }
+
+      *pixels = std::uint8_t(bits << (8 - count));
+    }
+
+    // The right border and the unused bits after it are black, cells past the width may have drawn into them
+    const std::int64_t border = std::int64_t(width) * cellBits;
+    line[1 + border / 8] &= std::uint8_t(0xff00 >> (border % 8));
+  }
+
+  void MazeImage::WriteChunk(const char* type, const std::uint8_t* data, std::size_t length)
+  {
+    std::uint8_t bytes[4];
+
+    PutBigEndian(bytes, std::uint32_t(length));
+    output.write(reinterpret_cast<const char*>(bytes), 4);
+    output.write(type, 4);
+    output.write(reinterpret_cast<const char*>(data), std::streamsize(length));
+
+    // The checksum covers the type and the data, crc32() restarts when it is handed no data at all
+    uLong checksum = crc32(0, reinterpret_cast<const Bytef*>(type), 4);
+
+    if (length > 0)
+    {
+      checksum = crc32(checksum, data, uInt(length));
+    }
+
+    PutBigEndian(bytes, std::uint32_t(checksum));
+    output.write(reinterpret_cast<const char*>(bytes), 4);
+  }
+
+  void WritePng(const PackedGrid& grid, std::ostream& output, int pathWidth)
+  {
+    MazeImage image(output, grid.Width(), grid.Height(), pathWidth);
+
+    std::vector<std::uint64_t> openRight((grid.Width() + 63) / 64);
+    std::vector<std::uint64_t> openDown(openRight.size());
+
+    for (int y = 0; y < grid.Height(); y++)
+    {
+      grid.ReadRow(y, openRight.data(), openDown.data());
+      image.AddRow(openRight.data(), openDown.data());
+    }
+  }
+}
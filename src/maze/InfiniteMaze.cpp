@@ -0,0 +1,149 @@
+#include "maze/InfiniteMaze.h"
+
+#include "maze/Generator.h"
+#include "maze/Random.h"
+
+#include <stdexcept>
+
+namespace maze
+{
+  // The splitmix64 finalizer, every input bit affects every output bit
+  static std::uint64_t Mix(std::uint64_t value)
+  {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+
+    return value ^ (value >> 31);
+  }
+
+  InfiniteMaze::InfiniteMaze(std::uint64_t seed, int chunkSize, const std::string& algorithm, std::size_t cacheCapacity) :
+    seed(seed),
+    chunkSize(chunkSize),
+    algorithm(algorithm),
+    cacheCapacity(cacheCapacity)
+  {
+    if (chunkSize < 1 or cacheCapacity < 1)
+    {
+      throw std::invalid_argument("An infinite maze needs chunks of at least 1x1 cells and room for at least one chunk");
+    }
+
+    PackedGrid grid(1, 1);
+
+    if (MakeGenerator(algorithm, grid) == nullptr)
+    {
+      throw std::invalid_argument("There is no algorithm called " + algorithm);
+    }
+
+    cachedChunks.reserve(cacheCapacity);
+  }
+
+  std::uint64_t InfiniteMaze::ChunkSeed(std::int64_t chunkX, std::int64_t chunkY) const
+  {
+    return Mix(Mix(seed ^ Mix(std::uint64_t(chunkX))) + std::uint64_t(chunkY));
+  }
+
+  PackedGrid InfiniteMaze::GenerateChunk(std::int64_t chunkX, std::int64_t chunkY) const
+  {
+    PackedGrid grid(chunkSize, chunkSize);
+
+    // The exit takes the first numbers of the chunk's own generator, the inside is generated from the next one
+    Random random(ChunkSeed(chunkX, chunkY));
+    random();
+    random();
+
+    std::unique_ptr<Generator<PackedGrid>> generator = MakeGenerator(algorithm, grid);
+    generator->Reset(random());
+    generator->Run();
+
+    return grid;
+  }
+
+  ChunkExit InfiniteMaze::Exit(std::int64_t chunkX, std::int64_t chunkY) const
+  {
+    Random random(ChunkSeed(chunkX, chunkY));
+
+    Direction direction = random() >> 63 ? UP : LEFT;
+
+    return ChunkExit{direction, int(random.Uniform(std::uint32_t(chunkSize)))};
+  }
+
+  const PackedGrid& InfiniteMaze::Chunk(std::int64_t chunkX, std::int64_t chunkY)
+  {
+    auto cached = cachedChunks.find({chunkX, chunkY});
+
+    // Moving the chunk to the front keeps the list ordered from the most to the least recently used one
+    if (cached != cachedChunks.end())
+    {
+      cacheHits++;
+      chunks.splice(chunks.begin(), chunks, cached->second);
+
+      return cached->second->grid;
+    }
+
+    cacheMisses++;
+
+    if (chunks.size() == cacheCapacity)
+    {
+      cachedChunks.erase({chunks.back().x, chunks.back().y});
+      chunks.pop_back();
+    }
+
+    chunks.push_front(CachedChunk{chunkX, chunkY, GenerateChunk(chunkX, chunkY)});
+    cachedChunks[{chunkX, chunkY}] = chunks.begin();
+
+    return chunks.front().grid;
+  }
+
+  bool InfiniteMaze::IsPassage(std::int64_t x, std::int64_t y, Direction direction)
+  {
+    const std::int64_t chunkX = ChunkOf(x);
+    const std::int64_t chunkY = ChunkOf(y);
+    const int localX = int(x - chunkX * chunkSize);
+    const int localY = int(y - chunkY * chunkSize);
+
+    // Passages through a border belong to the exit of the chunk below or to the right of it
+    switch (direction)
+    {
+      case UP:
+        if (localY == 0)
+        {
+          ChunkExit exit = Exit(chunkX, chunkY);
+
+          return exit.direction == UP and exit.position == localX;
+        }
+      break;
+
+      case LEFT:
+        if (localX == 0)
+        {
+          ChunkExit exit = Exit(chunkX, chunkY);
+
+          return exit.direction == LEFT and exit.position == localY;
+        }
+      break;
+
+      case DOWN:
+        if (localY == chunkSize - 1)
+        {
+          ChunkExit exit = Exit(chunkX, chunkY + 1);
+
+          return exit.direction == UP and exit.position == localX;
+        }
+      break;
+
+      case RIGHT:
+        if (localX == chunkSize - 1)
+        {
+          ChunkExit exit = Exit(chunkX + 1, chunkY);
+
+          return exit.direction == LEFT and exit.position == localY;
+        }
+      break;
+
+      default:
+        return false;
+    }
+
+    return Chunk(chunkX, chunkY).IsPassage(localX, localY, direction);
+  }
+}
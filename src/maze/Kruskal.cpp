@@ -0,0 +1,133 @@
+#include "maze/Kruskal.h"
+
+#include <stdexcept>
+
+namespace maze
+{
+  Kruskal::Kruskal(PackedGrid& grid) :
+    Generator<PackedGrid>(grid)
+  {
+    if (grid.CellCount() > std::int64_t(UINT32_MAX))
+    {
+      throw std::invalid_argument("Kruskal supports at most 2^32 cells");
+    }
+
+    // Every cell has a wall to the right (except the last column) and one below (except the last row)
+    wallCount = 2 * grid.CellCount();
+
+    // The permutation works on the smallest even number of bits that covers all wall numbers
+    while ((std::uint64_t(1) << (2 * permutationHalfBits)) < std::uint64_t(wallCount))
+    {
+      permutationHalfBits++;
+    }
+  }
+
+  void Kruskal::Reset(std::uint64_t seed)
+  {
+    Restart(seed);
+
+    parents.resize(grid.CellCount());
+
+    for (std::int64_t cell = 0; cell < grid.CellCount(); cell++)
+    {
+      parents[cell] = std::uint32_t(cell);
+    }
+
+    for (std::uint64_t& key : permutationKeys)
+    {
+      key = random();
+    }
+
+    nextWall = 0;
+    carvedPassages = 0;
+
+    // A maze with a single cell has no walls to open
+    if (grid.CellCount() == 1)
+    {
+      grid.MarkVisited(0);
+    }
+  }
+
+  bool Kruskal::Step()
+  {
+    if (IsDone())
+    {
+      return false;
+    }
+
+    lastCarving = Carving();
+
+    std::uint64_t wall = PermutedWall(nextWall++);
+    std::int64_t index = std::int64_t(wall >> 1);
+    Direction direction = (wall & 1) ? DOWN : RIGHT;
+    Point cell = grid.Coordinates(index);
+
+    // Walls on the right and lower border of the maze do not lead anywhere
+    if (not grid.HasNeighbour(cell.x, cell.y, direction))
+    {
+      return true;
+    }
+
+    std::uint32_t root = Find(std::uint32_t(index));
+    std::uint32_t neighbourRoot = Find(std::uint32_t(grid.Neighbour(index, direction)));
+
+    // Both cells are already connected, opening the wall would create a loop
+    if (root == neighbourRoot)
+    {
+      return true;
+    }
+
+    parents[root] = neighbourRoot;
+
+    grid.MarkVisited(index);
+    Carve(index, direction);
+
+    carvedPassages++;
+
+    return true;
+  }
+
+  void Kruskal::Run()
+  {
+    // Step() is final here, so this loop does not go through the virtual call
+    while (Step());
+  }
+
+  std::uint32_t Kruskal::Find(std::uint32_t cell)
+  {
+    while (parents[cell] != cell)
+    {
+      parents[cell] = parents[parents[cell]];
+      cell = parents[cell];
+    }
+
+    return cell;
+  }
+
+  std::uint64_t Kruskal::PermutedWall(std::uint64_t position) const
+  {
+    const std::uint64_t halfMask = (std::uint64_t(1) << permutationHalfBits) - 1;
+
+    // A Feistel network is a bijection on [0, 2^(2 * halfBits)), values outside of [0, wallCount) are walked
+    // through the cycle until they land inside, which keeps it a bijection on the walls
+    do
+    {
+      std::uint64_t left = position >> permutationHalfBits;
+      std::uint64_t right = position & halfMask;
+
+      for (std::uint64_t key : permutationKeys)
+      {
+        std::uint64_t mixed = (right ^ key) * 0x9e3779b97f4a7c15;
+        std::uint64_t next = left ^ ((mixed ^ (mixed >> 29)) & halfMask);
+
+        left = right;
+        right = next;
+      }
+
+      position = (left << permutationHalfBits) | right;
+    }
+    while (position >= std::uint64_t(wallCount));
+
+    return position;
+  }
+}
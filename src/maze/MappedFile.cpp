@@ -0,0 +1,308 @@
+#include "maze/MappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+  #define NOMINMAX
+  #include <windows.h>
+#else
+  #include <cerrno>
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace maze
+{
+  MappedFile::MappedFile(const std::filesystem::path& path, std::size_t size)
+  {
+    Open(path, READ_WRITE, true, size);
+  }
+
+  MappedFile::MappedFile(const std::filesystem::path& path, Mode mode)
+  {
+    Open(path, mode, false, 0);
+  }
+
+#if defined(_WIN32)
+
+  static std::runtime_error SystemError(const std::string& what)
+  {
+    return std::runtime_error(what + " failed with error " + std::to_string(GetLastError()));
+  }
+
+  void MappedFile::Open(const std::filesystem::path& path, Mode mode, bool resize, std::size_t newSize)
+  {
+    const bool isWritable = mode == READ_WRITE;
+
+    file = CreateFileW(path.c_str(), isWritable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, nullptr, resize ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      file = nullptr;
+
+      throw SystemError("Opening " + path.string());
+    }
+
+    LARGE_INTEGER fileSize;
+
+    if (resize)
+    {
+      fileSize.QuadPart = LONGLONG(newSize);
+
+      if (not SetFilePointerEx(file, fileSize, nullptr, FILE_BEGIN) or not SetEndOfFile(file))
+      {
+        CloseHandle(file);
+
+        throw SystemError("Resizing " + path.string());
+      }
+    }
+    else if (not GetFileSizeEx(file, &fileSize))
+    {
+      CloseHandle(file);
+
+      throw SystemError("Reading the size of " + path.string());
+    }
+
+    size = std::size_t(fileSize.QuadPart);
+
+    // An empty file can not be mapped, there is nothing to access either
+    if (size == 0)
+    {
+      return;
+    }
+
+    mapping = CreateFileMappingW(file, nullptr, isWritable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+
+    if (mapping == nullptr)
+    {
+      CloseHandle(file);
+
+      throw SystemError("Mapping " + path.string());
+    }
+
+    data = static_cast<std::uint8_t*>(MapViewOfFile(mapping, isWritable ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, 0));
+
+    if (data == nullptr)
+    {
+      CloseHandle(mapping);
+      CloseHandle(file);
+
+      throw SystemError("Mapping a view of " + path.string());
+    }
+  }
+
+  MappedFile::~MappedFile()
+  {
+    if (data != nullptr)
+    {
+      UnmapViewOfFile(data);
+    }
+
+    if (mapping != nullptr)
+    {
+      CloseHandle(mapping);
+    }
+
+    if (file != nullptr)
+    {
+      CloseHandle(file);
+    }
+  }
+
+  void MappedFile::Advise(Access)
+  {
+    // Windows reads ahead on its own and has no hint for mapped views
+  }
+
+  void MappedFile::Flush(std::size_t offset, std::size_t length, bool wait)
+  {
+    if (data == nullptr)
+    {
+      return;
+    }
+
+    FlushViewOfFile(data + offset, std::min(length, size - offset));
+
+    if (wait)
+    {
+      FlushFileBuffers(file);
+    }
+  }
+
+  void MappedFile::Evict(std::size_t offset, std::size_t length)
+  {
+    // Pages of a mapped file that are not locked are trimmed by the system once they have been written back
+    Flush(offset, length, false);
+  }
+
+  void MappedFile::Zero(std::size_t offset, std::size_t length)
+  {
+    if (data != nullptr)
+    {
+      std::memset(data + offset, 0, std::min(length, size - offset));
+    }
+  }
+
+#else
+
+  static std::runtime_error SystemError(const std::string& what)
+  {
+    return std::runtime_error(what + ": " + std::strerror(errno));
+  }
+
+  void MappedFile::Open(const std::filesystem::path& path, Mode mode, bool resize, std::size_t newSize)
+  {
+    const bool isWritable = mode == READ_WRITE;
+
+    descriptor = open(path.c_str(), (isWritable ? O_RDWR : O_RDONLY) | (resize ? O_CREAT : 0), 0644);
+
+    if (descriptor < 0)
+    {
+      throw SystemError("Opening " + path.string());
+    }
+
+    if (resize)
+    {
+      // Growing a file this way leaves a hole that takes no disk space until it is written to
+      if (ftruncate(descriptor, off_t(newSize)) != 0)
+      {
+        close(descriptor);
+
+        throw SystemError("Resizing " + path.string());
+      }
+
+      size = newSize;
+    }
+    else
+    {
+      struct stat status;
+
+      if (fstat(descriptor, &status) != 0)
+      {
+        close(descriptor);
+
+        throw SystemError("Reading the size of " + path.string());
+      }
+
+      size = std::size_t(status.st_size);
+    }
+
+    // An empty file can not be mapped, there is nothing to access either
+    if (size == 0)
+    {
+      return;
+    }
+
+    void* address = mmap(nullptr, size, isWritable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, descriptor, 0);
+
+    if (address == MAP_FAILED)
+    {
+      close(descriptor);
+
+      throw SystemError("Mapping " + path.string());
+    }
+
+    data = static_cast<std::uint8_t*>(address);
+  }
+
+  MappedFile::~MappedFile()
+  {
+    if (data != nullptr)
+    {
+      munmap(data, size);
+    }
+
+    if (descriptor >= 0)
+    {
+      close(descriptor);
+    }
+  }
+
+  void MappedFile::Advise(Access access)
+  {
+    if (data == nullptr)
+    {
+      return;
+    }
+
+    switch (access)
+    {
+      case NORMAL: madvise(data, size, MADV_NORMAL); break;
+      case SEQUENTIAL: madvise(data, size, MADV_SEQUENTIAL); break;
+      case RANDOM: madvise(data, size, MADV_RANDOM); break;
+    }
+  }
+
+  // The range grown outwards to whole pages, msync and madvise only take page aligned addresses
+  static void PageRange(std::size_t& offset, std::size_t& length, std::size_t size)
+  {
+    std::size_t pageSize = std::size_t(sysconf(_SC_PAGESIZE));
+    std::size_t end = std::min(offset + length, size);
+
+    offset = offset / pageSize * pageSize;
+    length = end > offset ? end - offset : 0;
+  }
+
+  void MappedFile::Flush(std::size_t offset, std::size_t length, bool wait)
+  {
+    if (data == nullptr)
+    {
+      return;
+    }
+
+    PageRange(offset, length, size);
+
+    if (msync(data + offset, length, wait ? MS_SYNC : MS_ASYNC) != 0)
+    {
+      throw SystemError("Flushing a mapped file");
+    }
+  }
+
+  void MappedFile::Evict(std::size_t offset, std::size_t length)
+  {
+    if (data == nullptr)
+    {
+      return;
+    }
+
+    PageRange(offset, length, size);
+
+    // The changes have to be in the file before the pages are dropped, otherwise the page cache still holds them as dirty
+    msync(data + offset, length, MS_SYNC);
+    madvise(data + offset, length, MADV_DONTNEED);
+  }
+
+  void MappedFile::Zero(std::size_t offset, std::size_t length)
+  {
+    if (data == nullptr)
+    {
+      return;
+    }
+
+    length = std::min(length, size - offset);
+
+    std::size_t pageSize = std::size_t(sysconf(_SC_PAGESIZE));
+    std::size_t first = (offset + pageSize - 1) / pageSize * pageSize;
+    std::size_t last = (offset + length) / pageSize * pageSize;
+
+#if defined(__linux__)
+    // Whole pages become a hole in the file, which reads as 0 without writing anything
+    if (first < last and fallocate(descriptor, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, off_t(first), off_t(last - first)) == 0)
+    {
+      std::memset(data + offset, 0, first - offset);
+      std::memset(data + last, 0, offset + length - last);
+
+      return;
+    }
+#endif
+
+    std::memset(data + offset, 0, length);
+  }
+
+#endif
+}
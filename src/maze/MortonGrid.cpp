@@ -0,0 +1,149 @@
+#include "maze/MortonGrid.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace maze
+{
+  // Number of bits needed for the coordinates 0 .. size - 1
+  static int BitsFor(int size)
+  {
+    int bits = 0;
+
+    while ((std::int64_t(1) << bits) < size)
+    {
+      bits++;
+    }
+
+    return bits;
+  }
+
+  MortonGrid::MortonGrid(int width, int height) :
+    width(width),
+    height(height)
+  {
+    if (width < 1 or height < 1)
+    {
+      throw std::invalid_argument("The maze needs to be at least 1x1 cells big");
+    }
+
+    int bitsX = BitsFor(width);
+    int bitsY = BitsFor(height);
+
+    if (bitsX + bitsY > 32)
+    {
+      throw std::invalid_argument("The Morton grid supports at most 2^32 cells including the padding");
+    }
+
+    commonBits = std::min(bitsX, bitsY);
+    lowMask = std::uint32_t((std::uint64_t(1) << commonBits) - 1);
+
+    // The interleaved part alternates x (even bits) and y (odd bits), the rest belongs to the larger side
+    std::uint64_t interleaved = (std::uint64_t(1) << (2 * commonBits)) - 1;
+    std::uint64_t all = (std::uint64_t(1) << (bitsX + bitsY)) - 1;
+
+    xMask = (interleaved & 0x5555555555555555) | (bitsX > bitsY ? all & ~interleaved : 0);
+    yMask = all & ~xMask;
+
+    words.resize(((std::int64_t(1) << (bitsX + bitsY)) + 63) / 64 * PLANE_COUNT);
+  }
+
+  Point MortonGrid::Coordinates(std::int64_t index) const
+  {
+    std::uint64_t low = std::uint64_t(index) & ((std::uint64_t(1) << (2 * commonBits)) - 1);
+    std::uint32_t x = Compact(low);
+    std::uint32_t y = Compact(low >> 1);
+
+    // The bits above the interleaved ones belong to the larger side
+    std::uint32_t high = std::uint32_t(std::uint64_t(index) >> (2 * commonBits));
+
+    if (xMask >> (2 * commonBits))
+    {
+      x |= high << commonBits;
+    }
+    else
+    {
+      y |= high << commonBits;
+    }
+
+    return Point{int(x), int(y)};
+  }
+
+  std::uint32_t MortonGrid::Compact(std::uint64_t value)
+  {
+    value &= 0x5555555555555555;
+    value = (value | (value >> 1)) & 0x3333333333333333;
+    value = (value | (value >> 2)) & 0x0f0f0f0f0f0f0f0f;
+    value = (value | (value >> 4)) & 0x00ff00ff00ff00ff;
+    value = (value | (value >> 8)) & 0x0000ffff0000ffff;
+    value = (value | (value >> 16)) & 0x00000000ffffffff;
+
+    return std::uint32_t(value);
+  }
+
+  void MortonGrid::Carve(std::int64_t index, Direction direction)
+  {
+    // Walls to the left and above are stored in the neighbour
+    std::int64_t neighbour = Neighbour(index, direction);
+
+    switch (direction)
+    {
+      case UP:
+        SetBit(neighbour, OPEN_DOWN);
+      break;
+
+      case LEFT:
+        SetBit(neighbour, OPEN_RIGHT);
+      break;
+
+      case DOWN:
+        SetBit(index, OPEN_DOWN);
+      break;
+
+      case RIGHT:
+        SetBit(index, OPEN_RIGHT);
+      break;
+
+      default:
+      return;
+    }
+
+    SetBit(neighbour, VISITED);
+  }
+
+  bool MortonGrid::HasNeighbour(int x, int y, Direction direction) const
+  {
+    switch (direction)
+    {
+      case UP: return y > 0;
+      case LEFT: return x > 0;
+      case DOWN: return y < height - 1;
+      case RIGHT: return x < width - 1;
+      default: return false;
+    }
+  }
+
+  bool MortonGrid::IsPassage(int x, int y, Direction direction) const
+  {
+    if (not HasNeighbour(x, y, direction))
+    {
+      return false;
+    }
+
+    std::int64_t index = Index(x, y);
+
+    switch (direction)
+    {
+      case UP: return IsOpenDown(Neighbour(index, UP));
+      case LEFT: return IsOpenRight(Neighbour(index, LEFT));
+      case DOWN: return IsOpenDown(index);
+      case RIGHT: return IsOpenRight(index);
+      default: return false;
+    }
+  }
+
+  void MortonGrid::Clear()
+  {
+    std::fill(words.begin(), words.end(), 0);
+  }
+}
@@ -0,0 +1,277 @@
+#include "maze/PackedGrid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace maze
+{
+  PackedGrid::PackedGrid(int width, int height) :
+    width(width),
+    height(height)
+  {
+    if (width < 1 or height < 1)
+    {
+      throw std::invalid_argument("The maze needs to be at least 1x1 cells big");
+    }
+
+    heapWords.resize((CellCount() + 63) / 64 * PLANE_COUNT);
+    words = heapWords.data();
+    wordCount = heapWords.size();
+  }
+
+  // Starts every file written by CreateMapped(), the words follow right after it
+  struct PackedGridFileHeader
+  {
+    char magic[8];
+    std::uint32_t version;
+    std::int32_t width;
+    std::int32_t height;
+    std::uint8_t reserved[44];
+  };
+
+  static_assert(sizeof(PackedGridFileHeader) == 64, "The words need to start 64 bytes into the file");
+
+  static const char packedGridMagic[8] = {'M', 'A', 'Z', 'E', 'G', 'R', 'I', 'D'};
+
+  // Number of words a grid needs, which is the same on the heap and in a file
+  static std::size_t WordCount(int width, int height)
+  {
+    return std::size_t((std::int64_t(width) * height + 63) / 64 * 3);
+  }
+
+  PackedGrid::PackedGrid(int width, int height, std::unique_ptr<MappedFile> file) :
+    width(width),
+    height(height),
+    mapping(std::move(file))
+  {
+    words = reinterpret_cast<std::uint64_t*>(mapping->Data() + sizeof(PackedGridFileHeader));
+    wordCount = WordCount(width, height);
+  }
+
+  PackedGrid::PackedGrid(const PackedGrid& other) :
+    width(other.width),
+    height(other.height),
+    heapWords(other.words, other.words + other.wordCount)
+  {
+    words = heapWords.data();
+    wordCount = heapWords.size();
+  }
+
+  PackedGrid& PackedGrid::operator=(const PackedGrid& other)
+  {
+    if (this != &other)
+    {
+      *this = PackedGrid(other);
+    }
+
+    return *this;
+  }
+
+  PackedGrid PackedGrid::CreateMapped(const std::filesystem::path& path, int width, int height)
+  {
+    if (width < 1 or height < 1)
+    {
+      throw std::invalid_argument("The maze needs to be at least 1x1 cells big");
+    }
+
+    std::size_t size = sizeof(PackedGridFileHeader) + WordCount(width, height) * sizeof(std::uint64_t);
+    auto file = std::make_unique<MappedFile>(path, size);
+
+    // An existing file may have had other contents, they are cut out instead of being overwritten
+    file->Zero(0, size);
+
+    PackedGridFileHeader header = {};
+    std::memcpy(header.magic, packedGridMagic, sizeof(header.magic));
+    header.version = 1;
+    header.width = width;
+    header.height = height;
+    std::memcpy(file->Data(), &header, sizeof(header));
+
+    return PackedGrid(width, height, std::move(file));
+  }
+
+  PackedGrid PackedGrid::OpenMapped(const std::filesystem::path& path, MappedFile::Mode mode)
+  {
+    auto file = std::make_unique<MappedFile>(path, mode);
+
+    PackedGridFileHeader header;
+
+    if (file->Size() < sizeof(header))
+    {
+      throw std::runtime_error(path.string() + " is no maze grid file");
+    }
+
+    std::memcpy(&header, file->Data(), sizeof(header));
+
+    if (std::memcmp(header.magic, packedGridMagic, sizeof(header.magic)) != 0 or header.version != 1 or header.width < 1 or header.height < 1 or file->Size() < sizeof(header) + WordCount(header.width, header.height) * sizeof(std::uint64_t))
+    {
+      throw std::runtime_error(path.string() + " is no maze grid file");
+    }
+
+    return PackedGrid(header.width, header.height, std::move(file));
+  }
+
+  bool PackedGrid::IsMappedFile(const std::filesystem::path& path)
+  {
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(packedGridMagic)] = {};
+
+    return file.read(magic, sizeof(magic)) and std::memcmp(magic, packedGridMagic, sizeof(magic)) == 0;
+  }
+
+  void PackedGrid::Carve(std::int64_t index, Direction direction)
+  {
+    // Walls to the left and above are stored in the neighbour
+    switch (direction)
+    {
+      case UP:
+        SetBit(index - width, OPEN_DOWN);
+        SetBit(index - width, VISITED);
+      break;
+
+      case LEFT:
+        SetBit(index - 1, OPEN_RIGHT);
+        SetBit(index - 1, VISITED);
+      break;
+
+      case DOWN:
+        SetBit(index, OPEN_DOWN);
+        SetBit(index + width, VISITED);
+      break;
+
+      case RIGHT:
+        SetBit(index, OPEN_RIGHT);
+        SetBit(index + 1, VISITED);
+      break;
+
+      default:
+      break;
+    }
+  }
+
+  bool PackedGrid::HasNeighbour(int x, int y, Direction direction) const
+  {
+    switch (direction)
+    {
+      case UP: return y > 0;
+      case LEFT: return x > 0;
+      case DOWN: return y < height - 1;
+      case RIGHT: return x < width - 1;
+      default: return false;
+    }
+  }
+
+  bool PackedGrid::IsPassage(int x, int y, Direction direction) const
+  {
+    if (not HasNeighbour(x, y, direction))
+    {
+      return false;
+    }
+
+    std::int64_t index = Index(x, y);
+
+    switch (direction)
+    {
+      case UP: return IsOpenDown(index - width);
+      case LEFT: return IsOpenRight(index - 1);
+      case DOWN: return IsOpenDown(index);
+      case RIGHT: return IsOpenRight(index);
+      default: return false;
+    }
+  }
+
+  void PackedGrid::Clear()
+  {
+    if (mapping)
+    {
+      mapping->Zero(sizeof(PackedGridFileHeader), wordCount * sizeof(std::uint64_t));
+      evictedBytes = 0;
+
+      return;
+    }
+
+    std::fill(heapWords.begin(), heapWords.end(), 0);
+  }
+
+  void PackedGrid::EvictRowsBefore(int endRow)
+  {
+    if (not mapping)
+    {
+      return;
+    }
+
+    // Only whole blocks of 64 cells before the row are done, the one the row starts in may still change
+    std::size_t endBytes = sizeof(PackedGridFileHeader) + std::size_t(Index(0, endRow) / 64 * PLANE_COUNT) * sizeof(std::uint64_t);
+
+    if (endBytes > evictedBytes)
+    {
+      mapping->Evict(evictedBytes, endBytes - evictedBytes);
+      evictedBytes = endBytes;
+    }
+  }
+
+  void PackedGrid::MergeTile(const PackedGrid& tile, int x, int y)
+  {
+    // Every row of the tile is a run of consecutive cells in both grids, it is moved over 64 cells at a time
+    for (int row = 0; row < tile.height; row++)
+    {
+      std::int64_t source = tile.Index(0, row);
+      std::int64_t target = Index(x, y + row);
+
+      for (int column = 0; column < tile.width; column += 64)
+      {
+        int count = std::min(64, tile.width - column);
+        std::uint64_t rowMask = count == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+
+        for (int plane = 0; plane < PLANE_COUNT; plane++)
+        {
+          SetBitsAtomically(target + column, Plane(plane), tile.Bits(source + column, Plane(plane)) & rowMask);
+        }
+      }
+    }
+  }
+
+  void PackedGrid::ReadRow(int y, std::uint64_t* openRight, std::uint64_t* openDown) const
+  {
+    for (int x = 0; x < width; x += 64)
+    {
+      // The last word of the row would otherwise pick up the start of the next row
+      std::uint64_t mask = width - x >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << (width - x)) - 1;
+
+      openRight[x >> 6] = Bits(Index(x, y), OPEN_RIGHT) & mask;
+      openDown[x >> 6] = Bits(Index(x, y), OPEN_DOWN) & mask;
+    }
+  }
+
+  void PackedGrid::WriteRow(int y, const std::uint64_t* openRight, const std::uint64_t* openDown)
+  {
+    for (int x = 0; x < width; x += 64)
+    {
+      std::uint64_t mask = width - x >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << (width - x)) - 1;
+
+      SetBitsAtomically(Index(x, y), OPEN_RIGHT, openRight[x >> 6] & mask);
+      SetBitsAtomically(Index(x, y), OPEN_DOWN, openDown[x >> 6] & mask);
+      SetBitsAtomically(Index(x, y), VISITED, mask);
+    }
+  }
+
+  void PackedGrid::SetBitsAtomically(std::int64_t index, Plane plane, std::uint64_t bits)
+  {
+    std::size_t word = (index >> 6) * PLANE_COUNT + plane;
+    int shift = index & 63;
+
+    if (bits << shift)
+    {
+      std::atomic_ref<std::uint64_t>(words[word]).fetch_or(bits << shift, std::memory_order_relaxed);
+    }
+
+    // The bits that do not fit into the first word spill over into the next one
+    if (shift != 0 and bits >> (64 - shift))
+    {
+      std::atomic_ref<std::uint64_t>(words[word + PLANE_COUNT]).fetch_or(bits >> (64 - shift), std::memory_order_relaxed);
+    }
+  }
+}
@@ -0,0 +1,76 @@
+#include "maze/Prim.h"
+
+namespace maze
+{
+  Prim::Prim(PackedGrid& grid) :
+    Generator<PackedGrid>(grid)
+  {}
+
+  void Prim::Reset(std::uint64_t seed)
+  {
+    Restart(seed);
+
+    frontier.clear();
+    isInFrontier.assign(grid.CellCount(), false);
+    peakFrontierSize = 0;
+
+    currentCell = 0;
+    grid.MarkVisited(currentCell);
+
+    AddNeighboursToFrontier(currentCell);
+  }
+
+  bool Prim::Step()
+  {
+    if (IsDone())
+    {
+      return false;
+    }
+
+    // Takes a random cell out of the frontier
+    std::size_t position = random.Uniform(std::uint32_t(frontier.size()));
+    std::int64_t index = frontier[position];
+
+    frontier[position] = frontier.back();
+    frontier.pop_back();
+
+    // Connects it to a random neighbour that is already part of the maze
+    NeighbourMask visitedNeighbours = grid.VisitedNeighbours(index, true);
+    Direction direction = NthOf(visitedNeighbours, random.Uniform(CountOf(visitedNeighbours)));
+
+    Carve(grid.Neighbour(index, direction), Reverse(direction));
+
+    currentCell = index;
+
+    AddNeighboursToFrontier(index);
+
+    return true;
+  }
+
+  void Prim::Run()
+  {
+    // Step() is final here, so this loop does not go through the virtual call
+    while (Step());
+  }
+
+  void Prim::AddNeighboursToFrontier(std::int64_t index)
+  {
+    NeighbourMask unvisitedNeighbours = grid.VisitedNeighbours(index, false);
+
+    for (int n = 0; n < CountOf(unvisitedNeighbours); n++)
+    {
+      std::int64_t neighbour = grid.Neighbour(index, NthOf(unvisitedNeighbours, n));
+
+      if (not isInFrontier[neighbour])
+      {
+        isInFrontier[neighbour] = true;
+        frontier.push_back(neighbour);
+      }
+    }
+
+    if (frontier.size() > peakFrontierSize)
+    {
+      peakFrontierSize = frontier.size();
+    }
+  }
+}
@@ -0,0 +1,16 @@
+#include "maze/Random.h"
+
+#include <chrono>
+#include <random>
+
+namespace maze
+{
+  std::uint64_t RandomSeed()
+  {
+    std::random_device device;
+
+    std::uint64_t seed = (std::uint64_t(device()) << 32) | device();
+
+    return seed ^ std::uint64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+  }
+}
@@ -0,0 +1,467 @@
+#include "maze/Solver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+namespace maze
+{
+  static void CheckInside(const PackedGrid& grid, Point cell)
+  {
+    if (cell.x < 0 or cell.y < 0 or cell.x >= grid.Width() or cell.y >= grid.Height())
+    {
+      throw std::invalid_argument("The cell " + std::to_string(cell.x) + "," + std::to_string(cell.y) + " does not lie inside the maze");
+    }
+  }
+
+  static bool BitOf(const std::vector<std::uint64_t>& bits, std::int64_t index)
+  {
+    return (bits[index >> 6] >> (index & 63)) & 1;
+  }
+
+  static void SetBitOf(std::vector<std::uint64_t>& bits, std::int64_t index)
+  {
+    bits[index >> 6] |= std::uint64_t(1) << (index & 63);
+  }
+
+  Solution SolveBreadthFirst(const PackedGrid& grid, Point start, Point goal)
+  {
+    CheckInside(grid, start);
+    CheckInside(grid, goal);
+
+    const std::int64_t width = grid.Width();
+    const std::int64_t blockCount = grid.BlockCount();
+    const std::int64_t startIndex = grid.Index(start.x, start.y);
+    const std::int64_t goalIndex = grid.Index(goal.x, goal.y);
+
+    // The distance modulo 3 plus 1 as two bit planes, 0 for cells that have not been reached yet
+    std::vector<std::uint64_t> lowLabels(blockCount, 0);
+    std::vector<std::uint64_t> highLabels(blockCount, 0);
+
+    // Cells of the current and of the next level, with the blocks that have any of them
+    std::vector<std::uint64_t> frontier(blockCount, 0);
+    std::vector<std::uint64_t> next(blockCount, 0);
+    std::vector<std::int64_t> frontierBlocks;
+    std::vector<std::int64_t> nextBlocks;
+
+    Solution solution;
+    int label = 1;
+
+    // Adds the cells of a block that have not been reached yet to the next level
+    auto reach = [&](std::int64_t block, std::uint64_t bits)
+    {
+      bits &= ~(lowLabels[block] | highLabels[block]);
+
+      if (bits == 0)
+      {
+        return;
+      }
+
+      lowLabels[block] |= label & 1 ? bits : 0;
+      highLabels[block] |= label & 2 ? bits : 0;
+
+      if (next[block] == 0)
+      {
+        nextBlocks.push_back(block);
+      }
+
+      next[block] |= bits;
+      solution.expandedCells += std::popcount(bits);
+    };
+
+    // Moves the bits of the cells starting at first by offset cells, which can spread them over two blocks
+    auto move = [&](std::int64_t first, std::uint64_t bits, std::int64_t offset)
+    {
+      if (bits == 0)
+      {
+        return;
+      }
+
+      // Bits only ever move onto cells inside the maze, so whatever would land outside of it is 0
+      const std::int64_t target = first + offset;
+      const std::int64_t block = target >> 6;
+      const int shift = int(target & 63);
+
+      if (block >= 0 and block < blockCount)
+      {
+        reach(block, bits << shift);
+      }
+
+      if (shift != 0 and block + 1 < blockCount)
+      {
+        reach(block + 1, bits >> (64 - shift));
+      }
+    };
+
+    reach(startIndex >> 6, std::uint64_t(1) << (startIndex & 63));
+
+    while (not nextBlocks.empty() and not BitOf(lowLabels, goalIndex) and not BitOf(highLabels, goalIndex))
+    {
+      std::swap(frontier, next);
+      std::swap(frontierBlocks, nextBlocks);
+      label = label % 3 + 1;
+
+      for (std::int64_t block : frontierBlocks)
+      {
+        const std::uint64_t bits = frontier[block];
+        const std::int64_t first = block * 64;
+        const BlockPassages passages = grid.PassagesOfBlock(block);
+
+        frontier[block] = 0;
+
+        move(first, bits & passages.up, -width);
+        move(first, bits & passages.left, -1);
+        move(first, bits & passages.down, width);
+        move(first, bits & passages.right, 1);
+      }
+
+      frontierBlocks.clear();
+    }
+
+    solution.memoryUsage = 4 * blockCount * sizeof(std::uint64_t) + (frontierBlocks.capacity() + nextBlocks.capacity()) * sizeof(std::int64_t);
+
+    auto labelOf = [&](std::int64_t index)
+    {
+      return int(BitOf(lowLabels, index)) | int(BitOf(highLabels, index)) << 1;
+    };
+
+    if (labelOf(goalIndex) == 0)
+    {
+      return solution;
+    }
+
+    // Neighbours differ by at most one step from the start, so the one with the label of the level before is one step closer
+    for (std::int64_t index = goalIndex; solution.path.push_back(index), index != startIndex;)
+    {
+      const int previousLabel = (labelOf(index) + 1) % 3 + 1;
+      const Point cell = grid.Coordinates(index);
+
+      for (int direction = UP; direction <= RIGHT; direction++)
+      {
+        if (grid.IsPassage(cell.x, cell.y, Direction(direction)) and labelOf(grid.Neighbour(index, Direction(direction))) == previousLabel)
+        {
+          index = grid.Neighbour(index, Direction(direction));
+
+          break;
+        }
+      }
+    }
+
+    std::reverse(solution.path.begin(), solution.path.end());
+
+    return solution;
+  }
+
+  Solution SolveAStar(const PackedGrid& grid, Point start, Point goal)
+  {
+    CheckInside(grid, start);
+    CheckInside(grid, goal);
+
+    if (grid.CellCount() >= (std::int64_t(1) << 31))
+    {
+      throw std::invalid_argument("A* needs a maze with less than 2^31 cells");
+    }
+
+    const std::int64_t blockCount = grid.BlockCount();
+    const std::int64_t startIndex = grid.Index(start.x, start.y);
+    const std::int64_t goalIndex = grid.Index(goal.x, goal.y);
+
+    // Cells that have been added to the heap, and the direction towards the cell they were added from as two bit planes
+    std::vector<std::uint64_t> added(blockCount, 0);
+    std::vector<std::uint64_t> lowParents(blockCount, 0);
+    std::vector<std::uint64_t> highParents(blockCount, 0);
+
+    // Keys of the open cells, the priority (steps so far plus the estimate) in the upper 32 bits and the index in the lower ones
+    // Comparing two keys compares their priorities first, a heap of plain integers keeps eight of them in a cache line
+    std::vector<std::uint64_t> heap;
+
+    auto estimate = [&](std::int64_t index)
+    {
+      const Point cell = grid.Coordinates(index);
+
+      return std::int64_t(std::abs(cell.x - goal.x) + std::abs(cell.y - goal.y));
+    };
+
+    auto add = [&](std::int64_t index, std::int64_t steps)
+    {
+      SetBitOf(added, index);
+      heap.push_back(std::uint64_t(steps + estimate(index)) << 32 | std::uint64_t(index));
+      std::push_heap(heap.begin(), heap.end(), std::greater<>());
+    };
+
+    Solution solution;
+    bool isFound = false;
+
+    add(startIndex, 0);
+
+    while (not heap.empty())
+    {
+      std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+      const std::uint64_t key = heap.back();
+      heap.pop_back();
+
+      const std::int64_t index = std::int64_t(key & 0xffffffff);
+      const std::int64_t steps = std::int64_t(key >> 32) - estimate(index);
+      solution.expandedCells++;
+
+      if (index == goalIndex)
+      {
+        isFound = true;
+
+        break;
+      }
+
+      const Point cell = grid.Coordinates(index);
+
+      for (int direction = UP; direction <= RIGHT; direction++)
+      {
+        if (not grid.IsPassage(cell.x, cell.y, Direction(direction)))
+        {
+          continue;
+        }
+
+        const std::int64_t neighbour = grid.Neighbour(index, Direction(direction));
+
+        if (BitOf(added, neighbour))
+        {
+          continue;
+        }
+
+        // Directions start at 1, the planes hold them minus 1
+        const int parent = Reverse(Direction(direction)) - 1;
+
+        if (parent & 1)
+        {
+          SetBitOf(lowParents, neighbour);
+        }
+
+        if (parent & 2)
+        {
+          SetBitOf(highParents, neighbour);
+        }
+
+        add(neighbour, steps + 1);
+      }
+    }
+
+    solution.memoryUsage = 3 * blockCount * sizeof(std::uint64_t) + heap.capacity() * sizeof(std::uint64_t);
+
+    if (not isFound)
+    {
+      return solution;
+    }
+
+    for (std::int64_t index = goalIndex; solution.path.push_back(index), index != startIndex;)
+    {
+      const int parent = int(BitOf(lowParents, index)) | int(BitOf(highParents, index)) << 1;
+      index = grid.Neighbour(index, Direction(parent + 1));
+    }
+
+    std::reverse(solution.path.begin(), solution.path.end());
+
+    return solution;
+  }
+
+  Solution SolveDeadEndFilling(const PackedGrid& grid, Point start, Point goal, int threadCount)
+  {
+    CheckInside(grid, start);
+    CheckInside(grid, goal);
+
+    if (threadCount < 1)
+    {
+      threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const std::int64_t width = grid.Width();
+    const std::int64_t cellCount = grid.CellCount();
+    const std::int64_t blockCount = grid.BlockCount();
+    const std::int64_t startIndex = grid.Index(start.x, start.y);
+    const std::int64_t goalIndex = grid.Index(goal.x, goal.y);
+
+    // A thread only pays off with a few thousand blocks to scan
+    threadCount = int(std::clamp<std::int64_t>(blockCount / 4096, 1, threadCount));
+    const bool isShared = threadCount > 1;
+
+    std::vector<std::uint64_t> filled(blockCount, 0);
+    Solution solution;
+
+    // Shared between threads the bits are set and read sequentially consistent
+    // A thread sets a cell's bit before it looks at the cell the corridor leads to, so of two corridors that reach a junction at the same time at least one sees the other one filled
+    auto isFilled = [&](std::int64_t index)
+    {
+      const std::uint64_t word = isShared ? std::atomic_ref<std::uint64_t>(filled[index >> 6]).load() : filled[index >> 6];
+
+      return unsigned(word >> (index & 63)) & 1;
+    };
+
+    auto fill = [&](std::int64_t index)
+    {
+      const std::uint64_t bit = std::uint64_t(1) << (index & 63);
+
+      if (isShared)
+      {
+        std::atomic_ref<std::uint64_t>(filled[index >> 6]).fetch_or(bit);
+      }
+      else
+      {
+        filled[index >> 6] |= bit;
+      }
+    };
+
+    // How far a step towards UP, LEFT, DOWN and RIGHT moves the index
+    const std::int64_t offsets[4] = {-width, -1, width, 1};
+
+    // The directions of a cell's passages that lead to cells which are not filled, bit d - 1 standing for direction d
+    // Which passages a cell has is close to random, so they are combined without branches, neighbours outside the maze are replaced by the cell itself and masked off
+    // The last cell of a row is never open to the right and the last row never downwards
+    auto openSides = [&](std::int64_t index)
+    {
+      const std::int64_t above = index >= width ? index - width : index;
+      const std::int64_t before = index > 0 ? index - 1 : index;
+      const std::int64_t below = index + width < cellCount ? index + width : index;
+      const std::int64_t after = index + 1 < cellCount ? index + 1 : index;
+
+      return (unsigned(index >= width and grid.IsOpenDown(above)) & ~isFilled(above))
+        | (unsigned(index > 0 and grid.IsOpenRight(before)) & ~isFilled(before)) << 1
+        | (unsigned(grid.IsOpenDown(index)) & ~isFilled(below)) << 2
+        | (unsigned(grid.IsOpenRight(index)) & ~isFilled(after)) << 3;
+    };
+
+    // Fills a dead end and follows its corridor for as long as the cells it leads to become dead ends as well
+    auto fillCorridor = [&](std::int64_t index)
+    {
+      fill(index);
+
+      unsigned sides = openSides(index);
+
+      while (sides != 0)
+      {
+        const std::int64_t next = index + offsets[std::countr_zero(sides)];
+
+        if (next == startIndex or next == goalIndex)
+        {
+          return;
+        }
+
+        const unsigned nextSides = openSides(next);
+
+        if (std::popcount(nextSides) > 1)
+        {
+          return;
+        }
+
+        fill(next);
+        index = next;
+
+        // Filling a cell does not change its own open sides, only another thread can have filled one of its neighbours in the meantime
+        sides = isShared ? openSides(next) : nextSides;
+      }
+    };
+
+    // Every thread scans its own range of blocks, the corridors it fills may run into the ranges of the others
+    auto work = [&](std::int64_t firstBlock, std::int64_t endBlock)
+    {
+      for (std::int64_t block = firstBlock; block < endBlock; block++)
+      {
+        const BlockPassages passages = grid.PassagesOfBlock(block);
+        const std::int64_t first = block * 64;
+
+        // Cells with at most one passage, which are all cells that do not have two of them
+        const std::uint64_t atLeastTwo = (passages.up & passages.left) | ((passages.up | passages.left) & (passages.down | passages.right)) | (passages.down & passages.right);
+        std::uint64_t deadEnds = ~atLeastTwo;
+
+        if (cellCount - first < 64)
+        {
+          deadEnds &= (std::uint64_t(1) << (cellCount - first)) - 1;
+        }
+
+        for (; deadEnds != 0; deadEnds &= deadEnds - 1)
+        {
+          const std::int64_t index = first + std::countr_zero(deadEnds);
+
+          // A corridor that started earlier may have filled it already
+          if (index != startIndex and index != goalIndex and not isFilled(index))
+          {
+            fillCorridor(index);
+          }
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (int thread = 1; thread < threadCount; thread++)
+    {
+      threads.emplace_back(work, blockCount * thread / threadCount, blockCount * (thread + 1) / threadCount);
+    }
+
+    // The calling thread takes the first range
+    work(0, blockCount / threadCount);
+
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+
+    // What is left is the path, cells are filled while walking it so that it never turns back
+    for (std::int64_t index = startIndex; solution.path.push_back(index), index != goalIndex;)
+    {
+      fill(index);
+
+      const unsigned sides = openSides(index);
+
+      if (sides == 0)
+      {
+        solution.path.clear();
+
+        break;
+      }
+
+      index += offsets[std::countr_zero(sides)];
+    }
+
+    for (std::uint64_t bits : filled)
+    {
+      solution.expandedCells += std::popcount(bits);
+    }
+
+    solution.memoryUsage = blockCount * sizeof(std::uint64_t);
+
+    return solution;
+  }
+
+  const std::vector<std::string>& SolverNames()
+  {
+    static const std::vector<std::string> names = {
+      "bfs",
+      "astar",
+      "dead-end-filling"
+    };
+
+    return names;
+  }
+
+  Solution Solve(const std::string& name, const PackedGrid& grid, Point start, Point goal, int threadCount)
+  {
+    if (name == "bfs")
+    {
+      return SolveBreadthFirst(grid, start, goal);
+    }
+
+    if (name == "astar")
+    {
+      return SolveAStar(grid, start, goal);
+    }
+
+    if (name == "dead-end-filling")
+    {
+      return SolveDeadEndFilling(grid, start, goal, threadCount);
+    }
+
+    throw std::invalid_argument("There is no solver called " + name);
+  }
+}
@@ -0,0 +1,94 @@
+#include "maze/TextFormat.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace maze
+{
+  void WriteText(const CellGrid& grid, std::ostream& output)
+  {
+    detail::WriteGrid(grid, output);
+  }
+
+  void WriteText(const PackedGrid& grid, std::ostream& output)
+  {
+    detail::WriteGrid(grid, output);
+  }
+
+  void WriteText(const MortonGrid& grid, std::ostream& output)
+  {
+    detail::WriteGrid(grid, output);
+  }
+
+  void WriteText(const ChunkedGrid& grid, std::ostream& output)
+  {
+    detail::WriteGrid(grid, output);
+  }
+
+  void WriteText(const MazeFileRows& rows, std::ostream& output)
+  {
+    detail::WriteGrid(rows, output);
+  }
+
+  // Rows of a grid seen as a maze of their own
+  class GridRows
+  {
+  public:
+    GridRows(const PackedGrid& grid, int firstRow, int endRow) :
+      grid(grid),
+      firstRow(firstRow),
+      height(endRow - firstRow)
+    {}
+
+    int Width() const { return grid.Width(); }
+    int Height() const { return height; }
+
+    bool IsPassage(int x, int y, Direction direction) const
+    {
+      return (direction != UP or y > 0) and (direction != DOWN or y < height - 1) and grid.IsPassage(x, firstRow + y, direction);
+    }
+
+  private:
+    const PackedGrid& grid;
+    int firstRow;
+    int height;
+  };
+
+  void WriteText(const PackedGrid& grid, int firstRow, int endRow, std::ostream& output)
+  {
+    if (firstRow < 0 or endRow > grid.Height() or firstRow > endRow)
+    {
+      throw std::invalid_argument("Rows " + std::to_string(firstRow) + " to " + std::to_string(endRow) + " do not lie inside a maze of height " + std::to_string(grid.Height()));
+    }
+
+    detail::WriteGrid(GridRows(grid, firstRow, endRow), output);
+  }
+
+  void WriteTextTop(int width, std::ostream& output)
+  {
+    output << std::string(2 * width + 1, '#') << '\n';
+  }
+
+  void WriteTextRow(const MazeRow& row, std::ostream& output)
+  {
+    std::string line(2 * row.Width() + 1, '#');
+
+    // The cells of this row and the walls between them
+    for (int x = 0; x < row.Width(); x++)
+    {
+      line[2 * x + 1] = ' ';
+      line[2 * x + 2] = row.IsOpenRight(x) ? ' ' : '#';
+    }
+
+    output << line << '\n';
+
+    // The walls below the cells of this row
+    for (int x = 0; x < row.Width(); x++)
+    {
+      line[2 * x + 1] = row.IsOpenDown(x) ? ' ' : '#';
+      line[2 * x + 2] = '#';
+    }
+
+    output << line << '\n';
+  }
+}
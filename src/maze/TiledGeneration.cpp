@@ -0,0 +1,195 @@
+#include "maze/TiledGeneration.h"
+
+#include "maze/Generator.h"
+#include "maze/Random.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+namespace maze
+{
+  // A wall between two neighbouring tiles, the second tile is to the right of or below the first one
+  struct Seam
+  {
+    std::int64_t first;
+    std::int64_t second;
+    Direction direction; // RIGHT or DOWN
+  };
+
+  static std::int64_t FindTile(std::vector<std::int64_t>& parents, std::int64_t tile)
+  {
+    while (parents[tile] != tile)
+    {
+      parents[tile] = parents[parents[tile]];
+      tile = parents[tile];
+    }
+
+    return tile;
+  }
+
+  TiledStatistics GenerateTiled(PackedGrid& grid, const std::string& algorithm, std::uint64_t seed, int threadCount, int tileSize)
+  {
+    if (tileSize < 1)
+    {
+      throw std::invalid_argument("Tiles need to be at least 1x1 cells big");
+    }
+
+    // Checked once up front, a worker thread could not hand the error on
+    PackedGrid probe(1, 1);
+
+    if (MakeGenerator(algorithm, probe) == nullptr)
+    {
+      throw std::invalid_argument("There is no algorithm called " + algorithm);
+    }
+
+    if (threadCount < 1)
+    {
+      threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const int tilesX = (grid.Width() + tileSize - 1) / tileSize;
+    const int tilesY = (grid.Height() + tileSize - 1) / tileSize;
+    const std::int64_t tileCount = std::int64_t(tilesX) * tilesY;
+
+    // There is no point in threads without a tile
+    threadCount = int(std::min<std::int64_t>(threadCount, tileCount));
+
+    TiledStatistics statistics;
+    statistics.workers.resize(threadCount);
+
+    grid.Clear();
+
+    std::atomic<std::int64_t> nextTile = 0;
+
+    // Every thread generates into its own small grid which is reused for all of its tiles
+    auto work = [&](TileWorkerStatistics& worker)
+    {
+      PackedGrid tile(std::min(tileSize, grid.Width()), std::min(tileSize, grid.Height()));
+      std::unique_ptr<Generator<PackedGrid>> generator = MakeGenerator(algorithm, tile);
+
+      auto start = std::chrono::steady_clock::now();
+
+      for (std::int64_t index = nextTile++; index < tileCount; index = nextTile++)
+      {
+        int x = int(index % tilesX) * tileSize;
+        int y = int(index / tilesX) * tileSize;
+        int width = std::min(tileSize, grid.Width() - x);
+        int height = std::min(tileSize, grid.Height() - y);
+
+        // Tiles at the right and lower border can be smaller, generators size themselves after their grid when they are created
+        if (tile.Width() != width or tile.Height() != height)
+        {
+          tile = PackedGrid(width, height);
+          generator = MakeGenerator(algorithm, tile);
+        }
+
+        generator->Reset(seed + index);
+        generator->Run();
+
+        grid.MergeTile(tile, x, y);
+
+        worker.tiles++;
+        worker.cells += tile.CellCount();
+      }
+
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      worker.seconds = elapsed.count();
+    };
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+
+    for (int thread = 1; thread < threadCount; thread++)
+    {
+      threads.emplace_back(work, std::ref(statistics.workers[thread]));
+    }
+
+    // The calling thread is worker 0
+    work(statistics.workers[0]);
+
+    for (std::thread& thread : threads)
+    {
+      thread.join();
+    }
+
+    auto generated = std::chrono::steady_clock::now();
+    statistics.generationSeconds = std::chrono::duration<double>(generated - start).count();
+
+    // Joining the tiles with Kruskal's algorithm on the tile graph, every tile is a perfect maze on its own so one passage per joined seam keeps the maze perfect
+    std::vector<Seam> seams;
+
+    for (int tileY = 0; tileY < tilesY; tileY++)
+    {
+      for (int tileX = 0; tileX < tilesX; tileX++)
+      {
+        std::int64_t index = std::int64_t(tileY) * tilesX + tileX;
+
+        if (tileX < tilesX - 1)
+        {
+          seams.push_back(Seam{index, index + 1, RIGHT});
+        }
+
+        if (tileY < tilesY - 1)
+        {
+          seams.push_back(Seam{index, index + tilesX, DOWN});
+        }
+      }
+    }
+
+    // A different stream than the one of tile 0
+    // Fisher-Yates on the own generator, std::shuffle's algorithm differs between standard libraries and with it the maze of a seed
+    Random random(seed ^ 0x5eed5eed5eed5eed);
+
+    // Only more than 2^32 seams need the slightly biased modulo
+    for (std::size_t i = seams.size(); i > 1; i--)
+    {
+      const std::size_t other = i <= UINT32_MAX ? random.Uniform(std::uint32_t(i)) : std::size_t(random() % i);
+
+      std::swap(seams[i - 1], seams[other]);
+    }
+
+    std::vector<std::int64_t> parents(tileCount);
+    std::iota(parents.begin(), parents.end(), std::int64_t(0));
+
+    for (const Seam& seam : seams)
+    {
+      std::int64_t first = FindTile(parents, seam.first);
+      std::int64_t second = FindTile(parents, seam.second);
+
+      if (first == second)
+      {
+        continue;
+      }
+
+      parents[second] = first;
+
+      // Opens a random wall along the seam, from the last column or row of the first tile
+      int x = int(seam.first % tilesX) * tileSize;
+      int y = int(seam.first / tilesX) * tileSize;
+
+      if (seam.direction == RIGHT)
+      {
+        int height = std::min(tileSize, grid.Height() - y);
+
+        grid.Carve(grid.Index(x + tileSize - 1, y + int(random.Uniform(height))), RIGHT);
+      }
+      else
+      {
+        int width = std::min(tileSize, grid.Width() - x);
+
+        grid.Carve(grid.Index(x + int(random.Uniform(width)), y + tileSize - 1), DOWN);
+      }
+    }
+
+    statistics.stitchingSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - generated).count();
+
+    return statistics;
+  }
+}
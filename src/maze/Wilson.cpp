@@ -0,0 +1,89 @@
+#include "maze/Wilson.h"
+
+namespace maze
+{
+  Wilson::Wilson(PackedGrid& grid) :
+    Generator<PackedGrid>(grid)
+  {}
+
+  void Wilson::Reset(std::uint64_t seed)
+  {
+    Restart(seed);
+
+    walkDirections.assign(grid.CellCount(), NOT_SET);
+
+    // The maze starts out as a single random cell
+    std::int64_t root = std::int64_t(random() % std::uint64_t(grid.CellCount()));
+    grid.MarkVisited(root);
+    visitedCells = 1;
+
+    nextStart = 0;
+    StartWalk();
+  }
+
+  bool Wilson::Step()
+  {
+    if (IsDone())
+    {
+      return false;
+    }
+
+    lastCarving = Carving();
+
+    if (isWalking)
+    {
+      // Walks into a random neighbour and remembers the direction it left in
+      Point cell = grid.Coordinates(currentCell);
+      NeighbourMask neighbours = grid.Neighbours(cell.x, cell.y);
+      Direction direction = NthOf(neighbours, random.Uniform(CountOf(neighbours)));
+
+      walkDirections[currentCell] = direction;
+      currentCell = grid.Neighbour(currentCell, direction);
+
+      // The walk has hit the maze and gets added to it from its start
+      if (grid.IsVisited(currentCell))
+      {
+        isWalking = false;
+        currentCell = walkStart;
+      }
+
+      return true;
+    }
+
+    // Follows the walk from its start, loops have been erased by overwriting the directions
+    Direction direction = walkDirections[currentCell];
+    std::int64_t next = grid.Neighbour(currentCell, direction);
+    bool hasReachedMaze = grid.IsVisited(next);
+
+    grid.MarkVisited(currentCell);
+    Carve(currentCell, direction);
+    visitedCells++;
+
+    currentCell = next;
+
+    if (hasReachedMaze)
+    {
+      StartWalk();
+    }
+
+    return true;
+  }
+
+  void Wilson::Run()
+  {
+    // Step() is final here, so this loop does not go through the virtual call
+    while (Step());
+  }
+
+  void Wilson::StartWalk()
+  {
+    while (nextStart < grid.CellCount() and grid.IsVisited(nextStart))
+    {
+      nextStart++;
+    }
+
+    walkStart = nextStart;
+    currentCell = nextStart;
+    isWalking = true;
+  }
+}